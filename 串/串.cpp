@@ -20,6 +20,11 @@
 // - 4.2 字符串的实现（P10–P42），包括 CharString 类与自定义 C 字符串函数
 // - 4.3 字符串模式匹配算法（P43–P60）：暴力匹配与 KMP（含 next 的求法）
 // - 4.4* 文本编辑器实例（P61–P88）：主程序、Editor 类、命令处理与插入示例
+// - 4.3（续，扩展）：直接在 std::string_view / 内存映射文件上做的快速查找——
+//   SIMD 首尾字节过滤的单模式查找 SubstringFinder（带 KMP 兜底，最坏线性），
+//   与多模式 Aho–Corasick 自动机（字节分类后的稠密转移表）
+// - 4.4*（续，扩展）：PieceTable（映射的只读原始缓冲区 + 只追加缓冲区 + 带行索引的
+//   片段树）与以它为缓冲区的 PieceTableEditor；输入文件较大时 main 自动选用
 //
 // 提示：
 // - 运行程序后，会先自动演示 4.1–4.3 的示例，然后进入 4.4 文本编辑器交互。
@@ -34,6 +39,25 @@
 #include <string>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <string_view>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define STRING_HAVE_SSE2 1
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STRING_HAVE_MMAP 1
+#endif
 using namespace std;
 
 // =============================================================
@@ -496,6 +520,475 @@ vector<int> FindAll(const CharString &T, const CharString &P, bool useKMP = true
     return pos;
 }
 
+// =============================================================
+// 4.3（续）快速查找：直接作用于 string_view，不必先拷贝成 CharString
+// - 上面的 Index_KMP/FindAll 每次调用都重算 next 数组、逐字节比较；
+//   这里的 SubstringFinder 构造时预处理一次模式串，之后可反复查找。
+// - 查找主循环：每次用 SSE2 同时比较 16 个候选起点的“首字节”和“尾字节”，
+//   两者都相等的候选才用 memcmp 校验中间部分。普通文本中绝大多数位置
+//   在过滤阶段就被排除，因此远快于逐字节的 KMP。
+// - 最坏情况（如在 "aaaa…" 中找 "aa…ab"）过滤失效，校验量会退化为 O(nm)；
+//   为此记录校验所花的字节数，超过“已扫描长度的 2 倍 + 4096”后，
+//   剩余部分改用同一模式的 KMP（P54 算法），整体保证 O(n+m)。
+//   FindAll 在各次命中之间共用这份预算，兜底时一趟 KMP 报告其余全部命中，
+//   因此在 "aaaa…" 中找 "aa…a" 这类命中密集的情形下也保持线性。
+// =============================================================
+inline int LowestSetBit(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int k = 0;
+    while (!(mask & 1u))
+    {
+        mask >>= 1;
+        ++k;
+    }
+    return k;
+#endif
+}
+
+class SubstringFinder
+{
+public:
+    static constexpr size_t npos = string_view::npos;
+
+    // pat 的内容被复制进来，构造后与原缓冲区无关
+    explicit SubstringFinder(string_view pat) : pattern(pat), next(pattern.size() + 1, 0)
+    {
+        // 与 KMP_GetNext 相同的 next 数组（next[0] = -1 风格，P57）
+        int i = 0, j = -1, m = (int)pattern.size();
+        next[0] = -1;
+        while (i < m)
+        {
+            if (j == -1 || pattern[i] == pattern[j])
+                next[++i] = ++j;
+            else
+                j = next[j];
+        }
+    }
+
+    size_t PatternLength() const { return pattern.size(); }
+
+    // 返回 text 中从 from（0-based）起首次出现的位置，找不到返回 npos
+    size_t Find(string_view text, size_t from = 0) const
+    {
+        size_t n = text.size(), m = pattern.size();
+        if (m == 0)
+            return from <= n ? from : npos;
+        size_t verified = 0;
+        bool exhausted = false;
+        size_t r = FilterScan(text, from, from, verified, exhausted);
+        return exhausted ? FindKmp(text, r) : r;
+    }
+
+    // 全部出现位置（允许重叠，与 FindAll 语义一致）。
+    // 校验预算在各次命中之间累计（命中本身的校验也计入），预算用尽后
+    // 余下部分改用一趟不回溯的 KMP 报告全部命中，因此周期性文本上同样是 O(n+m)
+    vector<size_t> FindAll(string_view text) const
+    {
+        vector<size_t> pos;
+        size_t m = pattern.size();
+        if (m == 0)
+            return pos;
+        size_t verified = 0, from = 0;
+        bool exhausted = false;
+        for (;;)
+        {
+            size_t r = FilterScan(text, from, 0, verified, exhausted);
+            if (exhausted)
+            {
+                KmpAll(text, r, pos);
+                break;
+            }
+            if (r == npos)
+                break;
+            pos.push_back(r);
+            from = r + 1;
+        }
+        return pos;
+    }
+
+    // 纯 KMP 查找（供兜底与对照）
+    size_t FindKmp(string_view text, size_t from = 0) const
+    {
+        int m = (int)pattern.size();
+        if (m == 0)
+            return from <= text.size() ? from : npos;
+        size_t i = from;
+        int j = 0;
+        while (i < text.size() && j < m)
+        {
+            if (j == -1 || text[i] == pattern[j])
+            {
+                ++i;
+                ++j;
+            }
+            else
+                j = next[j];
+        }
+        return j >= m ? i - m : npos;
+    }
+
+private:
+    // 首尾字节过滤扫描：返回从 from 起首个命中（或 npos）。每次 memcmp 校验
+    // 计 m 字节，累计超过“自 origin 起已扫描长度的 2 倍 + 4096”时置 exhausted，
+    // 返回值改为应改用 KMP 接着扫描的起点。verified 由调用者跨多次调用累计
+    size_t FilterScan(string_view text, size_t from, size_t origin, size_t &verified, bool &exhausted) const
+    {
+        size_t n = text.size(), m = pattern.size();
+        if (from >= n || n - from < m)
+            return npos;
+        const char *s = text.data();
+        if (m == 1)
+        {
+            const void *hit = memchr(s + from, pattern[0], n - from);
+            return hit ? (size_t)((const char *)hit - s) : npos;
+        }
+        const char first = pattern[0], last = pattern[m - 1];
+        const size_t end = n - m; // 最后一个可能的起点
+        size_t i = from;
+#ifdef STRING_HAVE_SSE2
+        const __m128i vf = _mm_set1_epi8(first), vl = _mm_set1_epi8(last);
+        for (; i + 15 <= end; i += 16)
+        {
+            if (verified > 2 * (i - origin) + 4096)
+            {
+                exhausted = true;
+                return i;
+            }
+            __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+            __m128i b = _mm_loadu_si128((const __m128i *)(s + i + m - 1));
+            unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, vf), _mm_cmpeq_epi8(b, vl)));
+            while (mask)
+            {
+                size_t cand = i + LowestSetBit(mask);
+                verified += m;
+                if (m == 2 || memcmp(s + cand + 1, pattern.data() + 1, m - 2) == 0)
+                    return cand;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; i <= end; ++i)
+        {
+            if (s[i] != first || s[i + m - 1] != last)
+                continue;
+            if (verified > 2 * (i - origin) + 4096)
+            {
+                exhausted = true;
+                return i;
+            }
+            verified += m;
+            if (memcmp(s + i + 1, pattern.data() + 1, m - 2) == 0)
+                return i;
+        }
+        return npos;
+    }
+
+    // 从 from 起一趟 KMP，命中后按 next[m] 继续（P57），把全部起点追加到 pos
+    void KmpAll(string_view text, size_t from, vector<size_t> &pos) const
+    {
+        int m = (int)pattern.size();
+        size_t i = from;
+        int j = 0;
+        while (i < text.size())
+        {
+            if (j == -1 || text[i] == pattern[j])
+            {
+                ++i;
+                ++j;
+                if (j == m)
+                {
+                    pos.push_back(i - m);
+                    j = next[m];
+                }
+            }
+            else
+                j = next[j];
+        }
+    }
+
+    string pattern;
+    vector<int> next;
+};
+
+// 便捷函数：一次性查找（会构造一次 SubstringFinder）
+inline size_t FastIndex(string_view text, string_view pat, size_t from = 0)
+{
+    return SubstringFinder(pat).Find(text, from);
+}
+
+// =============================================================
+// 4.3（续）多模式匹配：Aho–Corasick 自动机
+// - 在所有模式串构成的字典树上增加失败链接（相当于“多模式版”的 KMP next），
+//   对文本只扫一遍即可报告全部模式的全部出现，O(n + 模式总长 + 匹配数)。
+// - 稠密快速路径：先把 256 个字节分成等价类（未在任何模式中出现的字节归为
+//   第 0 类），再把“失败链接 + 转移”展开成 states × classes 的完全转移表，
+//   扫描时每个字节只需两次查表、没有分支回溯。表过大（超过 kDenseLimit 项）
+//   时退回字典树 + 失败链接的稀疏扫描。
+// - reportFrom[s] / outLink[t]：从 s 沿失败链可达的“有模式在此结束”的状态
+//   串成一条短链，报告匹配时只走这些终点，不遍历整条失败链。
+// =============================================================
+class AhoCorasick
+{
+public:
+    struct Match
+    {
+        size_t pos;  // 匹配起点（0-based）
+        int pattern; // 模式串编号（构造时的下标）
+    };
+    static constexpr size_t kDenseLimit = size_t(1) << 24;
+
+    explicit AhoCorasick(const vector<string> &patterns) : pats(patterns)
+    {
+        Build();
+    }
+
+    int PatternCount() const { return (int)pats.size(); }
+    const string &Pattern(int id) const { return pats[id]; }
+    int StateCount() const { return (int)nodes.size(); }
+    bool IsDense() const { return !delta.empty(); }
+
+    // 扫描 text，每个匹配调用一次 onMatch(pos, patternId)
+    template <typename Fn>
+    void Scan(string_view text, Fn onMatch) const
+    {
+        const unsigned char *s = (const unsigned char *)text.data();
+        size_t n = text.size();
+        int st = 0;
+        if (IsDense())
+        {
+            const int32_t *table = delta.data();
+            for (size_t i = 0; i < n; ++i)
+            {
+                st = table[(size_t)st * classes + classOf[s[i]]];
+                if (reportFrom[st] >= 0)
+                    Report(reportFrom[st], i, onMatch);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                st = Step(st, s[i]);
+                if (reportFrom[st] >= 0)
+                    Report(reportFrom[st], i, onMatch);
+            }
+        }
+    }
+
+    vector<Match> FindAll(string_view text) const
+    {
+        vector<Match> out;
+        Scan(text, [&](size_t pos, int id)
+             { out.push_back({pos, id}); });
+        return out;
+    }
+
+    // 只统计每个模式的出现次数
+    vector<size_t> CountAll(string_view text) const
+    {
+        vector<size_t> cnt(pats.size(), 0);
+        Scan(text, [&](size_t, int id)
+             { ++cnt[id]; });
+        return cnt;
+    }
+
+private:
+    struct Node
+    {
+        vector<pair<unsigned char, int>> child; // 字典树孩子（按字节有序）
+        int fail = 0;
+        int firstPattern = -1; // 在此结束的第一个模式（同名模式经 samePattern 串起来）
+    };
+
+    vector<string> pats;
+    vector<int> samePattern; // 同一终点上的下一个模式编号，-1 结束
+    vector<Node> nodes;
+    vector<int> reportFrom;  // 从该状态起第一个需报告的终点状态，无则 -1
+    vector<int> outLink;     // 终点状态 → 沿失败链的下一个终点状态
+    unsigned char classOf[256] = {};
+    int classes = 1;
+    vector<int32_t> delta;   // 稠密转移表（空表示未启用）
+
+    int Child(int st, unsigned char c) const
+    {
+        const auto &ch = nodes[st].child;
+        auto it = lower_bound(ch.begin(), ch.end(), make_pair(c, INT32_MIN));
+        return (it != ch.end() && it->first == c) ? it->second : -1;
+    }
+
+    int Step(int st, unsigned char c) const
+    {
+        for (;;)
+        {
+            int nx = Child(st, c);
+            if (nx >= 0)
+                return nx;
+            if (st == 0)
+                return 0;
+            st = nodes[st].fail;
+        }
+    }
+
+    template <typename Fn>
+    void Report(int t, size_t endPos, Fn &onMatch) const
+    {
+        for (; t >= 0; t = outLink[t])
+            for (int id = nodes[t].firstPattern; id >= 0; id = samePattern[id])
+                onMatch(endPos + 1 - pats[id].size(), id);
+    }
+
+    void Build()
+    {
+        nodes.assign(1, Node());
+        samePattern.assign(pats.size(), -1);
+        bool used[256] = {};
+        for (int id = 0; id < (int)pats.size(); ++id)
+        {
+            if (pats[id].empty())
+                continue; // 空模式不参与匹配
+            int st = 0;
+            for (char ch : pats[id])
+            {
+                unsigned char c = (unsigned char)ch;
+                used[c] = true;
+                int nx = Child(st, c);
+                if (nx < 0)
+                {
+                    nx = (int)nodes.size();
+                    nodes.emplace_back();
+                    auto &kids = nodes[st].child;
+                    kids.insert(lower_bound(kids.begin(), kids.end(), make_pair(c, INT32_MIN)), make_pair(c, nx));
+                }
+                st = nx;
+            }
+            samePattern[id] = nodes[st].firstPattern;
+            nodes[st].firstPattern = id;
+        }
+
+        // BFS 求失败链接：与 KMP 的 next 同理，fail(child) = goto(fail(parent), c)
+        vector<int> order;
+        order.reserve(nodes.size());
+        order.push_back(0);
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            int st = order[k];
+            for (const auto &e : nodes[st].child)
+            {
+                nodes[e.second].fail = st == 0 ? 0 : Step(nodes[st].fail, e.first);
+                order.push_back(e.second);
+            }
+        }
+
+        int S = (int)nodes.size();
+        outLink.assign(S, -1);
+        reportFrom.assign(S, -1);
+        for (int st : order)
+        {
+            if (st == 0)
+                continue;
+            int f = nodes[st].fail;
+            outLink[st] = nodes[f].firstPattern >= 0 ? f : outLink[f];
+            reportFrom[st] = nodes[st].firstPattern >= 0 ? st : outLink[st];
+        }
+
+        for (int c = 0; c < 256; ++c)
+            if (used[c])
+                classOf[c] = (unsigned char)classes++;
+        if (classes > 256)
+        {
+            // 256 个字节全用到时共 257 类，类号 256 放不进 unsigned char：退回稀疏扫描
+            return;
+        }
+        if ((size_t)S * classes > kDenseLimit)
+            return;
+
+        // 按 BFS 序填稠密表：有孩子取孩子，否则沿用失败状态的转移
+        delta.assign((size_t)S * classes, 0);
+        for (int st : order)
+        {
+            int32_t *row = &delta[(size_t)st * classes];
+            if (st != 0)
+            {
+                const int32_t *frow = &delta[(size_t)nodes[st].fail * classes];
+                for (int k = 0; k < classes; ++k)
+                    row[k] = frow[k];
+            }
+            else
+            {
+                for (int k = 0; k < classes; ++k)
+                    row[k] = 0;
+            }
+            for (const auto &e : nodes[st].child)
+                row[classOf[e.first]] = e.second;
+        }
+    }
+};
+
+// =============================================================
+// 只读内存映射文件：把大文件直接映射为 string_view 供上面的查找使用，
+// 不把内容读入 CharString。非 POSIX 平台退化为整体读入内存。
+// =============================================================
+class MappedFile
+{
+public:
+    explicit MappedFile(const string &path)
+    {
+#ifdef STRING_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw runtime_error("无法打开文件: " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw runtime_error("无法获取文件大小: " + path);
+        }
+        size = (size_t)st.st_size;
+        if (size > 0)
+        {
+            void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(fd);
+                throw runtime_error("mmap 失败: " + path);
+            }
+            data = (const char *)p;
+        }
+        ::close(fd);
+#else
+        ifstream in(path, ios::binary);
+        if (!in)
+            throw runtime_error("无法打开文件: " + path);
+        fallback.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data = fallback.data();
+        size = fallback.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef STRING_HAVE_MMAP
+        if (data && size)
+            ::munmap((void *)data, size);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    string_view View() const { return string_view(data ? data : "", size); }
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+#ifndef STRING_HAVE_MMAP
+    string fallback;
+#endif
+};
+
 // =============================================================
 // 4.4* 文本编辑器（P61–P88）
 // - 支持命令：R/W/I/D/F/C/Q/H/N/P/B/E/G/V（见 P63–P65）
@@ -868,6 +1361,776 @@ CharString Read(std::istream &in, char &terminalChar)
     return CharString(token.c_str());
 }
 
+// =============================================================
+// 4.4*（续）大文件文本缓冲区：piece table（片段表）
+// - Editor 用 DblLinkList<CharString> 保存每一行：每行一次堆分配，
+//   GotoLine / GetElem 按位置逐结点走链，F/C 命令还要整行拷贝。
+//   打开 GB 级日志时内存与时间都不可接受。
+// - PieceTable 不保存“行”，只保存两块缓冲区和一串“片段”：
+//     原始缓冲区 original：只读，通常是 MappedFile 映射的整个输入文件；
+//     追加缓冲区 added    ：只追加，插入的新文本都写到它的末尾；
+//     片段 piece          ：(哪块缓冲区, 起点, 长度)，按文本顺序排成的序列即全文。
+//   插入/删除只切分、增删片段，从不移动已有文本。
+// - 片段序列存放在以“文本位置”为隐式键的 treap（随机优先级的平衡二叉树）里，
+//   每个结点维护子树的总长度与总换行数，因此“第 k 行从哪开始”“位置 p 在第几行”
+//   都能自根向下 O(log n) 定位；这就是按行定位的索引树。
+// - 原始文件加载时按 kMaxPiece 切成片段，任何片段都不超过该长度，
+//   片段内部的换行查找（memchr）因而是常数代价。
+// - 查找/替换直接在片段上流式进行（SubstringFinder + 片段边界处的小窗口），
+//   不把行或全文拼接出来。
+// =============================================================
+class PieceTable
+{
+public:
+    static constexpr size_t npos = string_view::npos;
+    static constexpr size_t kMaxPiece = 64 * 1024;
+
+    PieceTable() : nodes(1) {} // nodes[0] 为空哨兵
+
+    // 以一段文本为原始内容（复制一份）
+    void Assign(string_view text)
+    {
+        Reset();
+        ownedOriginal.assign(text.data(), text.size());
+        original = ownedOriginal;
+        BuildFromOriginal();
+    }
+
+    // 以文件为原始内容：只读映射，不拷贝
+    void Load(const string &path)
+    {
+        Reset();
+        mapped.reset(new MappedFile(path));
+        original = mapped->View();
+        BuildFromOriginal();
+    }
+
+    size_t Length() const { return nodes[root].sumLen; }
+    size_t LineFeedCount() const { return nodes[root].sumLf; }
+    size_t PieceCount() const { return nodes.size() - 1 - freeList.size(); }
+
+    // 行数：与 getline 一致——末尾的 '\n' 不产生额外空行
+    size_t LineCount() const
+    {
+        size_t n = Length();
+        if (n == 0)
+            return 0;
+        return LineFeedCount() + (CharAt(n - 1) == '\n' ? 0 : 1);
+    }
+
+    char CharAt(size_t pos) const
+    {
+        char c = 0;
+        ForEachChunk(pos, pos + 1, [&](size_t, string_view sv)
+                     { c = sv[0]; return false; });
+        return c;
+    }
+
+    // 第 line 行（1-based）的起始位置；line 超出时返回 Length()
+    size_t LineStart(size_t line) const
+    {
+        if (line <= 1)
+            return 0;
+        size_t k = line - 1; // 要跨过的换行数
+        if (k > LineFeedCount())
+            return Length();
+        size_t base = 0;
+        int t = root;
+        while (t)
+        {
+            const Node &x = nodes[t];
+            if (nodes[x.l].sumLf >= k)
+            {
+                t = x.l;
+                continue;
+            }
+            k -= nodes[x.l].sumLf;
+            base += nodes[x.l].sumLen;
+            if (x.lf >= k)
+                return base + NthLineFeed(x, k) + 1;
+            k -= x.lf;
+            base += x.len;
+            t = x.r;
+        }
+        return Length();
+    }
+
+    // 位置 pos 所在的行号（1-based）：pos 之前的换行数 + 1
+    size_t LineOf(size_t pos) const
+    {
+        size_t acc = 0;
+        int t = root;
+        while (t)
+        {
+            const Node &x = nodes[t];
+            if (pos <= nodes[x.l].sumLen)
+            {
+                t = x.l;
+                continue;
+            }
+            pos -= nodes[x.l].sumLen;
+            acc += nodes[x.l].sumLf;
+            if (pos <= x.len)
+                return acc + CountLf(Text(x).substr(0, pos)) + 1;
+            pos -= x.len;
+            acc += x.lf;
+            t = x.r;
+        }
+        return acc + 1;
+    }
+
+    // 第 line 行的内容（不含 '\n'）：只拼出这一行
+    string Line(size_t line) const
+    {
+        size_t b = LineStart(line), e = line < LineFeedCount() + 1 ? LineStart(line + 1) : Length();
+        if (e > b && CharAt(e - 1) == '\n')
+            --e;
+        return Substr(b, e - b);
+    }
+
+    string Substr(size_t pos, size_t len) const
+    {
+        string out;
+        out.reserve(len);
+        ForEachChunk(pos, pos + len, [&](size_t, string_view sv)
+                     { out.append(sv.data(), sv.size()); return true; });
+        return out;
+    }
+
+    // 在 pos 前插入 text：文本写到追加缓冲区末尾，树中插入新片段（超长时分段）
+    void Insert(size_t pos, string_view text)
+    {
+        if (text.empty())
+            return;
+        pos = min(pos, Length());
+        int a, b;
+        Split(root, pos, a, b);
+        for (size_t off = 0; off < text.size(); off += kMaxPiece)
+        {
+            size_t len = min(kMaxPiece, text.size() - off);
+            int nd = NewNode(1, added.size(), len, CountLf(text.substr(off, len)));
+            added.append(text.data() + off, len);
+            a = Merge(a, nd);
+        }
+        root = Merge(a, b);
+    }
+
+    // 删除 [pos, pos+len)
+    void Erase(size_t pos, size_t len)
+    {
+        if (pos >= Length() || len == 0)
+            return;
+        len = min(len, Length() - pos);
+        int a, b, c;
+        Split(root, pos, a, b);
+        Split(b, len, b, c);
+        FreeTree(b);
+        root = Merge(a, c);
+    }
+
+    // 在 [from, to) 中查找 pat 的首次出现（匹配须完整落在范围内），流式跨片段
+    size_t Find(string_view pat, size_t from = 0, size_t to = npos) const
+    {
+        return Find(SubstringFinder(pat), from, to);
+    }
+
+    size_t Find(const SubstringFinder &finder, size_t from, size_t to = npos) const
+    {
+        size_t m = finder.PatternLength();
+        to = min(to, Length());
+        if (m == 0)
+            return from <= to ? from : npos;
+        if (from >= to || to - from < m)
+            return npos;
+        size_t found = npos;
+        string carry; // 已扫描文本末尾的至多 m-1 个字节，用于跨片段边界的匹配
+        size_t carryStart = from;
+        ForEachChunk(from, to, [&](size_t off, string_view sv)
+                     {
+            if (!carry.empty())
+            {
+                string window = carry;
+                window.append(sv.data(), min(sv.size(), m - 1));
+                size_t p = finder.Find(window);
+                if (p != npos && p < carry.size())
+                {
+                    found = carryStart + p;
+                    return false;
+                }
+            }
+            size_t p = finder.Find(sv);
+            if (p != npos)
+            {
+                found = off + p;
+                return false;
+            }
+            if (sv.size() >= m - 1)
+            {
+                carry.assign(sv.data() + sv.size() - (m - 1), m - 1);
+                carryStart = off + sv.size() - (m - 1);
+            }
+            else
+            {
+                carry.append(sv.data(), sv.size());
+                if (carry.size() > m - 1)
+                {
+                    carryStart += carry.size() - (m - 1);
+                    carry.erase(0, carry.size() - (m - 1));
+                }
+            }
+            return true; });
+        return found;
+    }
+
+    // 把 [from, to) 中 pat 的所有不重叠出现替换为 repl，返回替换次数
+    size_t ReplaceAll(string_view pat, string_view repl, size_t from = 0, size_t to = npos)
+    {
+        if (pat.empty())
+            return 0;
+        SubstringFinder finder(pat);
+        to = min(to, Length());
+        vector<size_t> hits;
+        for (size_t p = Find(finder, from, to); p != npos; p = Find(finder, p + pat.size(), to))
+            hits.push_back(p);
+        for (size_t k = hits.size(); k-- > 0;) // 从后往前改，前面的位置不受影响
+        {
+            Erase(hits[k], pat.size());
+            Insert(hits[k], repl);
+        }
+        return hits.size();
+    }
+
+    // 依次把 [from, to) 内各片段的文本交给 fn(绝对位置, string_view)；fn 返回 false 时停止
+    template <typename Fn>
+    void ForEachChunk(size_t from, size_t to, Fn fn) const
+    {
+        to = min(to, Length());
+        if (from < to)
+            Visit(root, 0, from, to, fn);
+    }
+
+    void WriteTo(ostream &out) const
+    {
+        ForEachChunk(0, Length(), [&](size_t, string_view sv)
+                     { out.write(sv.data(), (streamsize)sv.size()); return true; });
+    }
+
+private:
+    struct Node
+    {
+        unsigned char buf = 0; // 0：原始缓冲区；1：追加缓冲区
+        size_t start = 0, len = 0, lf = 0;
+        size_t sumLen = 0, sumLf = 0; // 子树合计
+        uint32_t pri = 0;
+        int l = 0, r = 0;
+    };
+
+    unique_ptr<MappedFile> mapped;
+    string ownedOriginal;
+    string_view original;
+    string added;
+    vector<Node> nodes;
+    vector<int> freeList;
+    int root = 0;
+    uint32_t seed = 2463534242u;
+
+    uint32_t NextPriority()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    static size_t CountLf(string_view sv)
+    {
+        size_t c = 0;
+        const char *p = sv.data(), *e = p + sv.size();
+        while ((p = (const char *)memchr(p, '\n', (size_t)(e - p))) != nullptr)
+        {
+            ++c;
+            ++p;
+        }
+        return c;
+    }
+
+    string_view Text(const Node &x) const
+    {
+        return (x.buf ? string_view(added) : original).substr(x.start, x.len);
+    }
+
+    // 片段内第 k 个（1-based）换行的偏移
+    size_t NthLineFeed(const Node &x, size_t k) const
+    {
+        string_view sv = Text(x);
+        const char *p = sv.data();
+        for (;;)
+        {
+            p = (const char *)memchr(p, '\n', (size_t)(sv.data() + sv.size() - p));
+            if (--k == 0)
+                return (size_t)(p - sv.data());
+            ++p;
+        }
+    }
+
+    int NewNode(unsigned char buf, size_t start, size_t len, size_t lf)
+    {
+        int id;
+        if (!freeList.empty())
+        {
+            id = freeList.back();
+            freeList.pop_back();
+        }
+        else
+        {
+            id = (int)nodes.size();
+            nodes.emplace_back();
+        }
+        Node &x = nodes[id];
+        x = Node();
+        x.buf = buf;
+        x.start = start;
+        x.len = len;
+        x.lf = lf;
+        x.pri = NextPriority();
+        Pull(id);
+        return id;
+    }
+
+    void Pull(int t)
+    {
+        Node &x = nodes[t];
+        x.sumLen = x.len + nodes[x.l].sumLen + nodes[x.r].sumLen;
+        x.sumLf = x.lf + nodes[x.l].sumLf + nodes[x.r].sumLf;
+    }
+
+    int Merge(int a, int b)
+    {
+        if (!a || !b)
+            return a ? a : b;
+        if (nodes[a].pri > nodes[b].pri)
+        {
+            nodes[a].r = Merge(nodes[a].r, b);
+            Pull(a);
+            return a;
+        }
+        nodes[b].l = Merge(a, nodes[b].l);
+        Pull(b);
+        return b;
+    }
+
+    // 按文本位置切分：前 pos 个字符进 a，其余进 b；位置落在片段中间时把片段一分为二
+    void Split(int t, size_t pos, int &a, int &b)
+    {
+        if (!t)
+        {
+            a = b = 0;
+            return;
+        }
+        Node &x = nodes[t];
+        size_t leftLen = nodes[x.l].sumLen;
+        if (pos <= leftLen)
+        {
+            int l = x.l, nl; // 递归中可能新建结点使 nodes 扩容，先用局部变量接收
+            Split(l, pos, a, nl);
+            nodes[t].l = nl;
+            Pull(t);
+            b = t;
+        }
+        else if (pos >= leftLen + x.len)
+        {
+            int r = x.r, nr;
+            Split(r, pos - leftLen - x.len, nr, b);
+            nodes[t].r = nr;
+            Pull(t);
+            a = t;
+        }
+        else
+        {
+            size_t k = pos - leftLen;
+            string_view tail = Text(x).substr(k);
+            size_t tailLf = CountLf(tail);
+            int nd = NewNode(nodes[t].buf, nodes[t].start + k, tail.size(), tailLf); // 可能使 x 失效
+            Node &y = nodes[t];
+            y.len = k;
+            y.lf -= tailLf;
+            int r = y.r;
+            y.r = 0;
+            Pull(t);
+            a = t;
+            b = Merge(nd, r);
+        }
+    }
+
+    void FreeTree(int t)
+    {
+        if (!t)
+            return;
+        FreeTree(nodes[t].l);
+        FreeTree(nodes[t].r);
+        freeList.push_back(t);
+    }
+
+    template <typename Fn>
+    bool Visit(int t, size_t base, size_t from, size_t to, Fn &fn) const
+    {
+        if (!t)
+            return true;
+        const Node &x = nodes[t];
+        size_t lo = base + nodes[x.l].sumLen, hi = lo + x.len;
+        if (from < lo && !Visit(x.l, base, from, to, fn))
+            return false;
+        if (from < hi && to > lo)
+        {
+            size_t b = max(from, lo), e = min(to, hi);
+            if (!fn(b, Text(x).substr(b - lo, e - b)))
+                return false;
+        }
+        if (to > hi)
+            return Visit(x.r, hi, from, to, fn);
+        return true;
+    }
+
+    void Reset()
+    {
+        nodes.assign(1, Node());
+        freeList.clear();
+        root = 0;
+        added.clear();
+        ownedOriginal.clear();
+        mapped.reset();
+        original = string_view();
+    }
+
+    void BuildFromOriginal()
+    {
+        for (size_t off = 0; off < original.size(); off += kMaxPiece)
+        {
+            size_t len = min(kMaxPiece, original.size() - off);
+            root = Merge(root, NewNode(0, off, len, CountLf(original.substr(off, len))));
+        }
+    }
+};
+
+// =============================================================
+// 以 PieceTable 为缓冲区的编辑器：命令集与 Editor 完全相同（P63–P65），
+// 但 R 命令只做内存映射并建立片段索引，G/N/P 按行号直接定位，
+// F/C 在片段上流式查找替换，W 逐片段按原样写出（不改动原有的换行）。
+// =============================================================
+class PieceTableEditor
+{
+private:
+    PieceTable text;
+    size_t curLineNo = 0;
+    string inName;
+    string outName;
+    char userCommand = 0;
+
+    bool UserSaysYes()
+    {
+        cout << "确认? (y/n): ";
+        char c = 'n';
+        cin >> c;
+        while (cin.get() != '\n')
+            ;
+        c = (char)tolower((unsigned char)c);
+        return c == 'y';
+    }
+
+    size_t Lines() const { return text.LineCount(); }
+
+    // 删除第 ln 行（含其换行符）；删除没有换行的末行时一并去掉前一行的换行
+    bool DeleteLine(size_t ln)
+    {
+        if (ln < 1 || ln > Lines())
+            return false;
+        size_t b = text.LineStart(ln), e = ln < Lines() ? text.LineStart(ln + 1) : text.Length();
+        if (ln == Lines() && b > 0 && (e == b || text.CharAt(e - 1) != '\n'))
+            --b;
+        text.Erase(b, e - b);
+        return true;
+    }
+
+    // 在第 ln 行之前插入一行（ln == Lines()+1 表示追加到末尾）
+    bool InsertLine(size_t ln, const string &line)
+    {
+        if (ln < 1 || ln > Lines() + 1)
+            return false;
+        if (ln == Lines() + 1 && text.Length() > 0 && text.CharAt(text.Length() - 1) != '\n')
+            text.Insert(text.Length(), "\n" + line);
+        else
+            text.Insert(text.LineStart(ln), line + "\n");
+        return true;
+    }
+
+public:
+    PieceTableEditor(const char *infName, const char *outfName) : inName(infName), outName(outfName) {}
+
+    bool GetCommand()
+    {
+        if (curLineNo != 0)
+            cout << curLineNo << " : " << text.Line(curLineNo) << "\n?";
+        else
+            cout << "文件缓存空\n?";
+        cin >> userCommand;
+        userCommand = (char)tolower((unsigned char)userCommand);
+        while (cin.get() != '\n')
+            ;
+        return userCommand != 'q';
+    }
+
+    void RunCommand()
+    {
+        switch (userCommand)
+        {
+        case 'b':
+            if (Lines() == 0)
+                cout << "警告: 文本缓存空\n";
+            else
+                curLineNo = 1;
+            break;
+
+        case 'c': // 当前行内替换：只在该行的字节范围内流式替换
+        {
+            if (curLineNo == 0)
+            {
+                cout << "警告: 文本缓存空\n";
+                break;
+            }
+            cout << "输入要查找的目标串: ";
+            string t = Read(cin).ToCStr();
+            cout << "替换为: ";
+            string r = Read(cin).ToCStr();
+            if (t.empty())
+            {
+                cout << "目标串为空，取消。\n";
+                break;
+            }
+            size_t b = text.LineStart(curLineNo);
+            size_t e = curLineNo < Lines() ? text.LineStart(curLineNo + 1) : text.Length();
+            size_t cnt = text.ReplaceAll(t, r, b, e);
+            if (cnt == 0)
+                cout << "当前行未找到目标串。\n";
+            else
+                cout << "已替换 " << cnt << " 处。\n";
+            break;
+        }
+
+        case 'd':
+            if (!DeleteLine(curLineNo))
+                cout << "错误: 删除失败\n";
+            else if (Lines() == 0)
+                curLineNo = 0;
+            else if (curLineNo > Lines())
+                curLineNo = Lines();
+            break;
+
+        case 'e':
+            if (Lines() == 0)
+                cout << "警告: 文本缓存空\n";
+            else
+                curLineNo = Lines();
+            break;
+
+        case 'f': // 从当前行起查找：一次流式 Find，再由位置反查行号
+        {
+            if (curLineNo == 0)
+            {
+                cout << "文本缓存空。\n";
+                break;
+            }
+            cout << "要查找的模式串: ";
+            string pat = Read(cin).ToCStr();
+            if (pat.empty())
+            {
+                cout << "模式串为空，取消。\n";
+                break;
+            }
+            size_t p = text.Find(pat, text.LineStart(curLineNo));
+            if (p == PieceTable::npos)
+                cout << "未匹配到。\n";
+            else
+            {
+                curLineNo = text.LineOf(p);
+                cout << "在第 " << curLineNo << " 行首次匹配到: " << text.Line(curLineNo) << "\n";
+            }
+            break;
+        }
+
+        case 'g':
+        {
+            cout << "转到哪一行(1.." << Lines() << "): ";
+            size_t ln = 0;
+            cin >> ln;
+            while (cin.get() != '\n')
+                ;
+            if (ln < 1 || ln > Lines())
+                cout << "错误: 操作失败\n";
+            else
+                curLineNo = ln;
+            break;
+        }
+
+        case '?':
+        case 'h':
+            cout << "有效命令: b(egin) c(hange) d(el) e(nd) f(ind) g(o) h(elp)\n"
+                 << "           i(nsert) n(ext) p(rior) q(uit) r(ead) v(iew) w(rite)\n";
+            break;
+
+        case 'i':
+        {
+            size_t ln = 0;
+            cout << "输入指定行号? ";
+            cin >> ln;
+            while (cin.get() != '\n')
+                ;
+            cout << "输入新行文本串: ";
+            string line = Read(cin).ToCStr();
+            if (InsertLine(ln, line))
+                curLineNo = ln;
+            else
+                cout << "错误: 操作失败\n";
+            break;
+        }
+
+        case 'n':
+            if (curLineNo == 0 || curLineNo >= Lines())
+                cout << "错误: 操作失败\n";
+            else
+                ++curLineNo;
+            break;
+
+        case 'p':
+            if (curLineNo <= 1)
+                cout << "错误: 操作失败\n";
+            else
+                --curLineNo;
+            break;
+
+        case 'r':
+            cout << "从输入文件读入内容（会覆盖当前缓冲区）——继续吗？\n";
+            if (!UserSaysYes())
+                break;
+            try
+            {
+                text.Load(inName);
+                curLineNo = Lines() > 0 ? 1 : 0;
+                cout << "已映射 " << text.Length() << " 字节，" << Lines() << " 行。\n";
+            }
+            catch (const exception &ex)
+            {
+                cout << "输入文件不可读：" << ex.what() << "\n";
+            }
+            break;
+
+        case 'v':
+            if (Lines() == 0)
+                cout << "[空]\n";
+            else
+                for (size_t i = 1; i <= Lines(); ++i)
+                    cout << setw(4) << i << " : " << text.Line(i) << "\n";
+            break;
+
+        case 'w':
+        {
+            if (Lines() == 0)
+            {
+                cout << "警告: 文本缓存空\n";
+                break;
+            }
+            // 写临时文件再改名：输出文件可能正是被映射的输入文件
+            string tmp = outName + ".tmp";
+            {
+                ofstream out(tmp, ios::binary | ios::trunc);
+                if (!out.good())
+                {
+                    cout << "输出文件不可写。\n";
+                    break;
+                }
+                text.WriteTo(out);
+            }
+            if (std::rename(tmp.c_str(), outName.c_str()) != 0)
+                cout << "输出文件不可写。\n";
+            else
+                cout << "已写出 " << Lines() << " 行。\n";
+            break;
+        }
+
+        default:
+            cout << "输入 h 或 ? 获得帮助；请键入有效命令字符。\n";
+        }
+    }
+};
+
+// =============================================================
+// 4.4*（续）的演示：PieceTable 与 DblLinkList<CharString> 的对照
+// - 1 万行文本上做随机“跳行取行 / 插入行 / 删除行”各若干次
+//   （DblLinkList 的尾插也要从头走到尾，建表本身就是 O(n²)，行数不宜再大）
+// =============================================================
+void Demo_PieceTable()
+{
+    cout << "\n===== 4.4*（续）PieceTable 演示 =====\n";
+    PieceTable pt;
+    pt.Assign("first line\nsecond line\nthird line\n");
+    pt.Insert(pt.LineStart(2), "inserted line\n");
+    pt.Erase(pt.LineStart(4), pt.LineStart(5) - pt.LineStart(4)); // 删除第 4 行
+    size_t rep = pt.ReplaceAll("line", "LINE");
+    cout << "行数 = " << pt.LineCount() << "，替换 " << rep << " 处：\n";
+    for (size_t i = 1; i <= pt.LineCount(); ++i)
+        cout << "  " << i << " : " << pt.Line(i) << "\n";
+    cout << "\"LINE\\nsec\" 跨片段查找位置 = " << pt.Find("LINE\nsec") << "，在第 " << pt.LineOf(pt.Find("sec")) << " 行\n";
+
+    const int lines = 10000, ops = 2000;
+    string big;
+    for (int i = 1; i <= lines; ++i)
+        big += "log line " + to_string(i) + " status=ok\n";
+    using Clock = chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b)
+    { return chrono::duration<double, milli>(b - a).count(); };
+    uint32_t seed = 7;
+    auto rnd = [&](int n)
+    { seed = seed * 1664525u + 1013904223u; return (int)((seed >> 8) % (uint32_t)n); };
+
+    auto t0 = Clock::now();
+    DblLinkList<CharString> list;
+    {
+        size_t b = 0;
+        for (size_t e; (e = big.find('\n', b)) != string::npos; b = e + 1)
+            list.Insert(list.Length() + 1, CharString(big.substr(b, e - b).c_str()));
+    }
+    auto t1 = Clock::now();
+    size_t sum1 = 0;
+    for (int k = 0; k < ops; ++k)
+    {
+        CharString line;
+        list.GetElem(1 + rnd(list.Length()), line);
+        sum1 += line.Length();
+        list.Insert(1 + rnd(list.Length()), CharString("new"));
+        list.Delete(1 + rnd(list.Length()));
+    }
+    auto t2 = Clock::now();
+
+    seed = 7;
+    PieceTable table;
+    table.Assign(big);
+    auto t3 = Clock::now();
+    size_t sum2 = 0;
+    for (int k = 0; k < ops; ++k)
+    {
+        sum2 += table.Line(1 + rnd((int)table.LineCount())).size();
+        table.Insert(table.LineStart(1 + rnd((int)table.LineCount())), "new\n");
+        size_t ln = 1 + rnd((int)table.LineCount());
+        table.Erase(table.LineStart(ln), table.LineStart(ln + 1) - table.LineStart(ln));
+    }
+    auto t4 = Clock::now();
+    cout << fixed << setprecision(2);
+    cout << lines << " 行，" << ops << " 轮随机 取行/插入/删除：\n"
+         << "  DblLinkList<CharString> 建表 " << ms(t0, t1) << " ms，操作 " << ms(t1, t2) << " ms\n"
+         << "  PieceTable              建表 " << ms(t2, t3) << " ms，操作 " << ms(t3, t4) << " ms，片段数 "
+         << table.PieceCount() << (sum1 == sum2 ? "（结果一致）" : "（结果不一致!）") << "\n";
+    cout.unsetf(ios::floatfield);
+}
+
 // =============================================================
 // 4.2.3 的演示程序片段（对应补例 4.5 的输出效果，P41–P42）
 // =============================================================
@@ -919,6 +2182,76 @@ void Demo_Matching()
         cout << "next[" << i << "]=" << nxt[i] << (i + 1 == nxt.size() ? '\n' : ' ');
 }
 
+// =============================================================
+// 4.3（续）的演示：SubstringFinder / AhoCorasick 与 KMP 的对照
+// - 构造约 4 MB 的模拟日志，单模式比较 FindAll(KMP) 与 SubstringFinder，
+//   多模式比较“逐个模式跑 SubstringFinder”与一遍 Aho–Corasick
+// =============================================================
+void Demo_FastSearch()
+{
+    cout << "\n===== 4.3（续）快速查找演示 =====\n";
+    string_view sample = "A man with money is no match against a man on a mission";
+    SubstringFinder man("man");
+    cout << "SubstringFinder(\"man\") 位置 = ";
+    for (size_t p : man.FindAll(sample))
+        cout << p << ' ';
+    cout << "\n";
+    AhoCorasick ac({"man", "an", "mission", "no match"});
+    cout << "AhoCorasick{man, an, mission, no match}: ";
+    for (const auto &m : ac.FindAll(sample))
+        cout << "(" << m.pos << "," << ac.Pattern(m.pattern) << ") ";
+    cout << "\n";
+
+    // 模拟日志
+    string log;
+    const char *levels[] = {"INFO", "DEBUG", "WARN", "ERROR"};
+    uint32_t seed = 12345;
+    auto rnd = [&]()
+    { seed = seed * 1103515245u + 12345u; return (seed >> 8) & 0xffffff; };
+    while (log.size() < (4u << 20))
+    {
+        log += "2024-06-01T12:";
+        log += to_string(10 + rnd() % 50);
+        log += " [";
+        log += levels[rnd() % 4];
+        log += "] worker-" + to_string(rnd() % 64) + " request_id=" + to_string(rnd()) + " latency_ms=" + to_string(rnd() % 900) + "\n";
+    }
+    vector<string> needles;
+    for (int k = 0; k < 200; ++k)
+        needles.push_back("request_id=" + to_string(rnd()));
+    needles.push_back("latency_ms=899\n");
+
+    using Clock = chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b)
+    { return chrono::duration<double, milli>(b - a).count(); };
+
+    CharString logStr(log.c_str());
+    CharString pat("latency_ms=899\n");
+    auto t0 = Clock::now();
+    vector<int> kmpHits = FindAll(logStr, pat, true);
+    auto t1 = Clock::now();
+    vector<size_t> fastHits = SubstringFinder(needles.back()).FindAll(log);
+    auto t2 = Clock::now();
+    bool same = kmpHits.size() == fastHits.size() && equal(kmpHits.begin(), kmpHits.end(), fastHits.begin(), [](int a, size_t b)
+                                                       { return (size_t)a == b; });
+    cout << fixed << setprecision(2);
+    cout << "单模式 " << log.size() / 1024 << " KB：FindAll(KMP) " << ms(t0, t1) << " ms，SubstringFinder "
+         << ms(t1, t2) << " ms，命中 " << fastHits.size() << (same ? "（一致）" : "（不一致!）") << "\n";
+
+    t0 = Clock::now();
+    size_t naive = 0;
+    for (const string &nd : needles)
+        naive += SubstringFinder(nd).FindAll(log).size();
+    t1 = Clock::now();
+    AhoCorasick multi(needles);
+    size_t acHits = multi.FindAll(log).size();
+    t2 = Clock::now();
+    cout << needles.size() << " 个模式：逐个 SubstringFinder " << ms(t0, t1) << " ms，Aho–Corasick（含建表，"
+         << (multi.IsDense() ? "稠密表" : "稀疏") << "，" << multi.StateCount() << " 状态）" << ms(t1, t2)
+         << " ms，命中 " << acHits << (acHits == naive ? "（一致）" : "（不一致!）") << "\n";
+    cout.unsetf(ios::floatfield);
+}
+
 // =============================================================
 // 4.1/4.2 的演示：CharString 构造、拷贝、连接、子串等
 // =============================================================
@@ -958,6 +2291,8 @@ int main()
     Demo_CharString_Basics(); // 4.1/4.2
     Demo_CStrFuncs();         // 4.2.3
     Demo_Matching();          // 4.3
+    Demo_FastSearch();        // 4.3（续）
+    Demo_PieceTable();        // 4.4*（续）
 
     // --- 进入 4.4 文本编辑器 ---
     char infName[256] = {0}, outfName[256] = {0};
@@ -972,11 +2307,30 @@ int main()
     if (std::strlen(outfName) == 0)
         CStrCopy(outfName, "file_out.txt");
 
-    Editor text(infName, outfName);
+    // 输入文件不小于 kPieceTableThreshold（或定义了 STRING_EDITOR_PIECE_TABLE）时
+    // 改用 PieceTableEditor：命令完全相同，但不会把整个文件逐行读进链表
+    const streamoff kPieceTableThreshold = 32 << 20;
+    ifstream probe(infName, ios::binary | ios::ate);
+    bool usePieceTable = probe && probe.tellg() >= kPieceTableThreshold;
+    probe.close();
+#ifdef STRING_EDITOR_PIECE_TABLE
+    usePieceTable = true;
+#endif
     cout << "键入 h 或 ? 查看帮助；q 退出。\n";
-    while (text.GetCommand())
+    if (usePieceTable)
     {
-        text.RunCommand();
+        cout << "（使用 PieceTable 缓冲区）\n";
+        PieceTableEditor text(infName, outfName);
+        while (text.GetCommand())
+            text.RunCommand();
+    }
+    else
+    {
+        Editor text(infName, outfName);
+        while (text.GetCommand())
+        {
+            text.RunCommand();
+        }
     }
     cout << "Bye.\n";
     return 0;
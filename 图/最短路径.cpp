@@ -3,6 +3,8 @@
  * 功能：实现
  *   1）单源点最短路径：Dijkstra 算法
  *   2）所有顶点对之间的最短路径：Floyd 算法
+ *   3）稀疏图上的 Dijkstra：CSR 压缩存储 + 索引 d 叉堆（decrease-key）
+ *   4）分块（tiled）+ 多线程 Floyd：连续行优先缓冲区，按阶段并行
  *
  * 主要知识点对应课件：
  *   - 7.6 最短路径 (Shortest Path)          （课件 P107 以后）
@@ -15,6 +17,8 @@
 #include <vector>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 
@@ -196,7 +200,373 @@ void printFloydPath(const vector<vector<int>> &path, int i, int j) {
 }
 
 /************************************************************
- * 三、简单主函数，演示 Dijkstra 与 Floyd
+ * 三、稀疏图 Dijkstra —— CSR 压缩存储 + 索引 d 叉堆
+ *
+ * 邻接矩阵版本的问题：
+ *   - 存储 O(V^2)：百万级顶点的路网根本放不进内存；
+ *   - 每轮线性扫描选最小 dist：总时间 O(V^2)。
+ *
+ * 改进思路：
+ *   - 用 CSR（Compressed Sparse Row，压缩稀疏行）存图：
+ *       offset[u] .. offset[u+1]-1 是顶点 u 的出边在 adj/weight 中的下标区间，
+ *       所有出边连续存放，遍历邻接点时顺序访问内存；
+ *   - 用“索引 d 叉堆”代替线性扫描选最小 dist：
+ *       堆中存顶点编号，pos[v] 记录 v 在堆中的位置，
+ *       松弛时 dist[v] 变小，直接对 v 做 decrease-key（上滤），
+ *       每个顶点最多入堆一次，堆大小不超过 V。
+ *   - 总时间 O((V + E) log_d V)，存储 O(V + E)。
+ *
+ * 输出的 dist/path 含义与第一部分完全一致，printPath 可直接复用。
+ ************************************************************/
+
+// 边：u -> v，权值 w（用于批量构建 CSR）
+struct Edge {
+    int u, v, w;
+};
+
+// CSR 图：offset 长度为 n+1，adj/weight 长度为 m
+struct CSRGraph {
+    int n = 0;
+    vector<int> offset;
+    vector<int> adj;
+    vector<int> weight;
+
+    int vexNum() const { return n; }
+    int edgeNum() const { return static_cast<int>(adj.size()); }
+};
+
+// 函数：由边表构建 CSR（计数排序，两遍扫描，O(V + E)）
+// 参数：
+//   n     - 顶点数
+//   edges - 边表，顶点编号须在 [0, n) 内（非法的边会被跳过）
+CSRGraph buildCSR(int n, const vector<Edge> &edges) {
+    CSRGraph g;
+    g.n = n;
+    g.offset.assign(n + 1, 0);
+
+    // ① 统计每个顶点的出度（与稀疏矩阵快速转置中的 cNum 同理）
+    for (const Edge &e : edges) {
+        if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) continue;
+        ++g.offset[e.u + 1];
+    }
+    // ② 前缀和得到每个顶点出边的起始位置（对应 cPos）
+    for (int u = 0; u < n; ++u) {
+        g.offset[u + 1] += g.offset[u];
+    }
+
+    // ③ 按起始位置把边依次放入
+    g.adj.resize(g.offset[n]);
+    g.weight.resize(g.offset[n]);
+    vector<int> cur(g.offset.begin(), g.offset.end() - 1);
+    for (const Edge &e : edges) {
+        if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) continue;
+        int k = cur[e.u]++;
+        g.adj[k] = e.v;
+        g.weight[k] = e.w;
+    }
+    return g;
+}
+
+// 函数：由邻接矩阵构建 CSR（便于与第一部分的结果对照）
+CSRGraph matrixToCSR(const vector<vector<int>> &graph) {
+    int n = static_cast<int>(graph.size());
+    vector<Edge> edges;
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            if (u != v && graph[u][v] < INF) {
+                edges.push_back({u, v, graph[u][v]});
+            }
+        }
+    }
+    return buildCSR(n, edges);
+}
+
+// 索引 d 叉小顶堆：堆中存放顶点编号，按 key[v] 排序
+//   - heap[i]  : 堆中第 i 个位置上的顶点
+//   - pos[v]   : 顶点 v 在 heap 中的位置，-1 表示不在堆中
+//   - D 取 4 时，一个结点的孩子在内存中相邻，下滤时比较更集中，树高也更低
+template <int D = 4>
+class IndexedDaryHeap {
+    static_assert(D >= 2, "IndexedDaryHeap: D 至少为 2");
+
+public:
+    explicit IndexedDaryHeap(const vector<int> &key)
+        : key_(key), pos_(key.size(), -1) {
+        heap_.reserve(key.size());
+    }
+
+    bool empty() const { return heap_.empty(); }
+    int size() const { return static_cast<int>(heap_.size()); }
+    bool contains(int v) const { return pos_[v] != -1; }
+    int top() const { return heap_[0]; }
+
+    // 插入顶点 v（key_[v] 已由调用者设置好）
+    void push(int v) {
+        pos_[v] = static_cast<int>(heap_.size());
+        heap_.push_back(v);
+        siftUp(pos_[v]);
+    }
+
+    // key_[v] 变小后调用，O(log_d n)
+    void decreaseKey(int v) { siftUp(pos_[v]); }
+
+    // 弹出 key 最小的顶点
+    int pop() {
+        int v = heap_[0];
+        int last = heap_.back();
+        heap_.pop_back();
+        pos_[v] = -1;
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            pos_[last] = 0;
+            siftDown(0);
+        }
+        return v;
+    }
+
+private:
+    const vector<int> &key_;
+    vector<int> heap_;
+    vector<int> pos_;
+
+    // 上滤：用“挖坑”方式移动，避免反复 swap
+    void siftUp(int i) {
+        int v = heap_[i];
+        int k = key_[v];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            int p = heap_[parent];
+            if (key_[p] <= k) break;
+            heap_[i] = p;
+            pos_[p] = i;
+            i = parent;
+        }
+        heap_[i] = v;
+        pos_[v] = i;
+    }
+
+    // 下滤：在 D 个孩子中选最小者
+    void siftDown(int i) {
+        int n = static_cast<int>(heap_.size());
+        int v = heap_[i];
+        int k = key_[v];
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n) break;
+            int last = min(first + D, n);
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (key_[heap_[c]] < key_[heap_[best]]) best = c;
+            }
+            if (key_[heap_[best]] >= k) break;
+            heap_[i] = heap_[best];
+            pos_[heap_[i]] = i;
+            i = best;
+        }
+        heap_[i] = v;
+        pos_[v] = i;
+    }
+};
+
+// 函数：稀疏图 Dijkstra
+// 参数：
+//   g      - CSR 图，边权须非负
+//   s      - 源点编号
+//   dist   - 输出：源点到各点的最短距离（不可达为 INF）
+//   path   - 输出：最短路径上的直接前驱（与 dijkstra() 含义相同）
+//   target - 可选终点：target 出堆（最短路径已确定）时立即结束，-1 表示求全部
+// 说明：
+//   提前结束时，只有已出堆顶点的 dist/path 是最终值，其余顶点为当前的上界。
+void dijkstraSparse(const CSRGraph &g, int s,
+                    vector<int> &dist, vector<int> &path, int target = -1) {
+    int n = g.n;
+    dist.assign(n, INF);
+    path.assign(n, -1);
+    vector<char> settled(n, 0); // 对应集合 U
+
+    IndexedDaryHeap<4> heap(dist);
+    dist[s] = 0;
+    heap.push(s);
+
+    while (!heap.empty()) {
+        int v1 = heap.pop();    // 取 V-U 中 dist 最小的顶点
+        settled[v1] = 1;
+        if (v1 == target) break; // 终点已确定，提前结束
+
+        const int d1 = dist[v1];
+        for (int k = g.offset[v1]; k < g.offset[v1 + 1]; ++k) {
+            int v2 = g.adj[k];
+            if (settled[v2]) continue;
+            // 用 long long 做加法，避免 d1 + w 溢出 int
+            long long nd = static_cast<long long>(d1) + g.weight[k];
+            if (nd < dist[v2]) {
+                dist[v2] = static_cast<int>(nd);
+                path[v2] = v1;
+                if (heap.contains(v2)) heap.decreaseKey(v2);
+                else heap.push(v2);
+            }
+        }
+    }
+}
+
+/************************************************************
+ * 四、分块 + 多线程 Floyd —— 连续缓冲区上的 tiled Floyd–Warshall
+ *
+ * 第二部分的 k -> i -> j 三重循环，每一轮 k 都要把整个 n×n 矩阵扫一遍，
+ * 且 vector<vector<int>> 每行单独分配，V 超过数千后完全受内存带宽限制。
+ *
+ * 分块思路（Blocked Floyd–Warshall）：
+ *   把矩阵划分为 B×B 的块，对第 kb 个“中间点块”分三个阶段：
+ *     阶段 1：只更新对角块 (kb, kb)，其依赖只来自自身；
+ *     阶段 2：更新第 kb 行的块 (kb, j) 与第 kb 列的块 (i, kb)，
+ *             它们只依赖自身和对角块，彼此独立，可并行；
+ *     阶段 3：更新其余所有块 (i, j)，只依赖 (i, kb) 与 (kb, j)，
+ *             这两者已在阶段 2 确定，因此所有块可并行。
+ *   每个块的计算只触及三个 B×B 子块，可常驻缓存。
+ *
+ * 路径：与第二部分相同，pred[i][j] 为 i 到 j 最短路径上 j 的前驱；
+ *   经 k 更新时 pred[i][j] = pred[k][j]。块内 (k, j) 的 dist 与 pred
+ *   总是同时写入，且阶段划分保证读取时不会被其它线程修改。
+ *
+ * 正确性说明：
+ *   dist 取值不超过 INF = 1e9，两个 dist 相加不超过 2e9 < INT_MAX，不会溢出。
+ *   但有负权边时 INF + w（w < 0）会小于 INF，被误当作一条可达路径，
+ *   因此内层循环与 floyd() 一样也要剪掉 k->j 不可达的情形。
+ ************************************************************/
+
+// 在 C 块上用 A、B 两块做一次“min-plus”更新：
+//   C(i, j) = min(C(i, j), A(i, k) + B(k, j))，k 取遍中间点块 kb
+// 参数：
+//   d, p    - n×n 行优先的 dist / pred 缓冲区
+//   ib, jb  - C 块的起始行、起始列
+//   kb      - 中间点块的起始下标
+//   bs      - 块大小
+static void floydTile(int n, int *d, int *p, int ib, int jb, int kb, int bs) {
+    const int iEnd = min(ib + bs, n);
+    const int jEnd = min(jb + bs, n);
+    const int kEnd = min(kb + bs, n);
+    for (int k = kb; k < kEnd; ++k) {
+        const int *dk = d + static_cast<size_t>(k) * n; // 第 k 行
+        const int *pk = p + static_cast<size_t>(k) * n;
+        for (int i = ib; i < iEnd; ++i) {
+            int *di = d + static_cast<size_t>(i) * n;
+            int *pi = p + static_cast<size_t>(i) * n;
+            const int dik = di[k];
+            if (dik >= INF) continue; // 剪枝：i->k 不可达
+            for (int j = jb; j < jEnd; ++j) {
+                const int dkj = dk[j];
+                const int cand = dik + dkj;
+                if (dkj < INF && cand < di[j]) { // 剪枝：k->j 不可达
+                    di[j] = cand;
+                    pi[j] = pk[j];
+                }
+            }
+        }
+    }
+}
+
+// 把 [0, count) 平均分给若干线程执行 fn(idx)，并等待全部完成
+template <typename Fn>
+static void parallelFor(int count, int threads, Fn fn) {
+    if (threads <= 1 || count <= 1) {
+        for (int idx = 0; idx < count; ++idx) fn(idx);
+        return;
+    }
+    threads = min(threads, count);
+    vector<thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([=, &fn]() {
+            for (int idx = t; idx < count; idx += threads) fn(idx);
+        });
+    }
+    for (thread &w : workers) w.join();
+}
+
+// 函数：分块 + 多线程 Floyd（连续缓冲区版本）
+// 参数：
+//   n         - 顶点数
+//   d         - 输入：n×n 行优先邻接矩阵（INF 表示无边）；输出：最短距离
+//   p         - 输出：n×n 行优先前驱矩阵，-1 表示无前驱 / 不可达
+//   blockSize - 块大小，默认 64（3 个 64×64 的 int 块约 48KB）
+//   threads   - 线程数，0 表示使用 hardware_concurrency()
+void floydBlockedFlat(int n, vector<int> &d, vector<int> &p,
+                      int blockSize = 64, int threads = 0) {
+    if (blockSize <= 0) blockSize = 64;
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+
+    // ① 初始化：与 floyd() 相同的 D^(-1) 与 path
+    p.assign(static_cast<size_t>(n) * n, -1);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            size_t ij = static_cast<size_t>(i) * n + j;
+            if (i == j) {
+                d[ij] = 0;
+            } else if (d[ij] < INF) {
+                p[ij] = i;
+            } else {
+                d[ij] = INF;
+            }
+        }
+    }
+
+    const int nb = (n + blockSize - 1) / blockSize; // 每行 / 列的块数
+    int *dp = d.data();
+    int *pp = p.data();
+
+    for (int b = 0; b < nb; ++b) {
+        const int kb = b * blockSize;
+
+        // ② 阶段 1：对角块
+        floydTile(n, dp, pp, kb, kb, kb, blockSize);
+
+        // ③ 阶段 2：第 b 行与第 b 列上的块（共 2*(nb-1) 个）
+        parallelFor(2 * nb, threads, [&](int idx) {
+            int other = idx / 2;
+            if (other == b) return;
+            if (idx % 2 == 0) {
+                floydTile(n, dp, pp, kb, other * blockSize, kb, blockSize); // 行块 (b, other)
+            } else {
+                floydTile(n, dp, pp, other * blockSize, kb, kb, blockSize); // 列块 (other, b)
+            }
+        });
+
+        // ④ 阶段 3：其余块，按块行分给各线程
+        parallelFor(nb, threads, [&](int ibk) {
+            if (ibk == b) return;
+            for (int jbk = 0; jbk < nb; ++jbk) {
+                if (jbk == b) continue;
+                floydTile(n, dp, pp, ibk * blockSize, jbk * blockSize, kb, blockSize);
+            }
+        });
+    }
+}
+
+// 函数：分块 + 多线程 Floyd（与 floyd() 相同的接口）
+// 说明：内部拷贝到一块连续缓冲区计算，结束后再展开为 vector<vector<int>>，
+//       因此 printFloydPath 可直接使用输出的 path。
+void floydBlocked(const vector<vector<int>> &graph,
+                  vector<vector<int>> &dist,
+                  vector<vector<int>> &path,
+                  int blockSize = 64, int threads = 0) {
+    int n = static_cast<int>(graph.size());
+    vector<int> d(static_cast<size_t>(n) * n), p;
+    for (int i = 0; i < n; ++i) {
+        copy(graph[i].begin(), graph[i].end(), d.begin() + static_cast<size_t>(i) * n);
+    }
+
+    floydBlockedFlat(n, d, p, blockSize, threads);
+
+    dist.assign(n, vector<int>(n));
+    path.assign(n, vector<int>(n));
+    for (int i = 0; i < n; ++i) {
+        copy(d.begin() + static_cast<size_t>(i) * n, d.begin() + static_cast<size_t>(i + 1) * n, dist[i].begin());
+        copy(p.begin() + static_cast<size_t>(i) * n, p.begin() + static_cast<size_t>(i + 1) * n, path[i].begin());
+    }
+}
+
+/************************************************************
+ * 五、简单主函数，演示 Dijkstra 与 Floyd
  *
  * 输入格式示例：
  *
@@ -227,8 +597,9 @@ int main() {
         return 0;
     }
 
-    // 初始化邻接矩阵
+    // 初始化邻接矩阵（同时保留边表，供稀疏版本构建 CSR）
     vector<vector<int>> graph(n, vector<int>(n, INF));
+    vector<Edge> edges;
     for (int i = 0; i < n; ++i) {
         graph[i][i] = 0;
     }
@@ -243,6 +614,7 @@ int main() {
         }
         // 若有多条边，只保留最小权值
         graph[u][v] = min(graph[u][v], w);
+        edges.push_back({u, v, w});
     }
 
     /*********************** Dijkstra 演示 ************************/
@@ -270,6 +642,31 @@ int main() {
         }
     }
 
+    /*********************** 稀疏 Dijkstra 演示 ************************/
+    cout << "\n===== 稀疏图 Dijkstra（CSR + 索引 4 叉堆） =====\n";
+    CSRGraph csr = buildCSR(n, edges);
+    vector<int> distSparse, pathSparse;
+    dijkstraSparse(csr, s, distSparse, pathSparse);
+
+    bool same = true;
+    for (int v = 0; v < n; ++v) {
+        if (distSparse[v] != dist[v]) same = false;
+    }
+    cout << "CSR：顶点数 = " << csr.vexNum() << " ，边数 = " << csr.edgeNum() << "\n";
+    cout << "与邻接矩阵版本的最短距离" << (same ? "一致" : "不一致") << "\n";
+
+    // 提前结束：只求到编号最大的顶点
+    int target = n - 1;
+    dijkstraSparse(csr, s, distSparse, pathSparse, target);
+    cout << "提前结束（终点 " << target << "）：";
+    if (distSparse[target] == INF) {
+        cout << "不可达\n";
+    } else {
+        cout << "距离 = " << distSparse[target] << " ，路径：";
+        printPath(pathSparse, target);
+        cout << "\n";
+    }
+
     /*********************** Floyd 演示 ************************/
     cout << "\n===== Floyd 所有顶点对最短路径 =====\n";
     vector<vector<int>> distFloyd, pathFloyd;
@@ -294,6 +691,12 @@ int main() {
         cout << "\n";
     }
 
+    // 分块 Floyd：用很小的块（2×2）演示，结果应与普通 Floyd 一致
+    vector<vector<int>> distBlocked, pathBlocked;
+    floydBlocked(graph, distBlocked, pathBlocked, 2, 2);
+    cout << "\n分块 + 多线程 Floyd（块大小 2，线程数 2）与普通 Floyd 的距离矩阵"
+         << (distBlocked == distFloyd ? "一致" : "不一致") << "\n";
+
     cout << "\n示例：打印任意一对顶点 (i, j) 的路径\n";
     cout << "请输入 i 和 j（-1 -1 结束）：\n";
     while (true) {
@@ -310,6 +713,9 @@ int main() {
         } else {
             printFloydPath(pathFloyd, i, j);
             cout << " ，总权值 = " << distFloyd[i][j] << "\n";
+            cout << "（分块 Floyd 路径：";
+            printFloydPath(pathBlocked, i, j);
+            cout << "）\n";
         }
     }
 
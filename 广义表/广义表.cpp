@@ -11,14 +11,81 @@
  *   • 广义表是元素可为原子或子表的线性序列；有“表头/head、表尾/tail、
  *     深度/Depth”等概念（P63–P64）。
  *   • 本实现中的“引用数 ref”记录某子表（其头结点）的被引用次数（P69）。
+ *
+ * 扩展（面向大规模、深嵌套的输入）：
+ *   • 结点从固定块结点池分配（类内 operator new/delete），不再逐个向系统申请。
+ *   • 解析器基于 string_view 与显式栈，嵌套再深也不占用调用栈；整体 O(n)。
+ *   • 哈希合并（hash-consing）：解析时结构相同的子表只建一份，由 ref 计数共享。
+ *   • 深度、长度、显示、复制、释放均非递归；深度按子表记忆化，在共享结构上
+ *     只需访问每个不同的子表一次，且对同一表的重复查询 O(1)。
  ******************************************************/
 
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cctype>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+#include <chrono>
+
+//========================= 结点池（扩展） =========================//
+
+// 固定大小块的结点池：按块（倍增，上限 4096 个）批量申请，释放的块挂入空闲链表复用。
+// 与 ref 计数一样不做线程同步；块只在程序结束时归还系统。
+template <std::size_t Size, std::size_t Align>
+class FixedBlockPool {
+    union Slot {
+        Slot* next;
+        alignas(Align) unsigned char storage[Size];
+    };
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    Slot* freeList{nullptr};
+    Slot* cur{nullptr};
+    Slot* end{nullptr};
+    std::size_t nextChunk{64};
+
+    FixedBlockPool() = default;
+
+public:
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    static FixedBlockPool& Instance() {
+        static FixedBlockPool pool;
+        return pool;
+    }
+
+    void* Allocate() {
+        if (freeList) {
+            Slot* s = freeList;
+            freeList = s->next;
+            return s->storage;
+        }
+        if (cur == end) {
+            chunks.emplace_back(new Slot[nextChunk]);
+            cur = chunks.back().get();
+            end = cur + nextChunk;
+            if (nextChunk < 4096) nextChunk *= 2;
+        }
+        return (cur++)->storage;
+    }
+
+    void Deallocate(void* p) noexcept {
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = freeList;
+        freeList = s;
+    }
+
+    std::size_t ChunkCount() const { return chunks.size(); }
+};
 
 //========================= 结点与枚举（P69–P72） =========================//
 
@@ -45,6 +112,18 @@ struct RefGenListNode {
         : tag(tg), nextLink(next) {
         // 其余 union 成员按实际使用场景赋值
     }
+
+    // （扩展）所有 new/delete 走结点池；派生类等其他大小仍交给全局分配
+    static auto& Pool() {  // 函数体内类型已完整，才能取 sizeof
+        return FixedBlockPool<sizeof(RefGenListNode), alignof(RefGenListNode)>::Instance();
+    }
+    static void* operator new(std::size_t n) {
+        return n == sizeof(RefGenListNode) ? Pool().Allocate() : ::operator new(n);
+    }
+    static void operator delete(void* p, std::size_t n) noexcept {
+        if (n == sizeof(RefGenListNode)) Pool().Deallocate(p);
+        else ::operator delete(p);
+    }
 };
 
 //============================ 广义表类（P74–P76） ============================//
@@ -52,169 +131,293 @@ struct RefGenListNode {
 template <class ElemType>
 class RefGenList {
 protected:
+    using Node = RefGenListNode<ElemType>;
+
     RefGenListNode<ElemType>* head;  // 头指针（指向 HEAD 头结点，见 P74）
 
-    // —— 辅助：显示（递归）（P74）
-    void ShowHelp(const RefGenListNode<ElemType>* hd) const {
-        std::cout << "(";
-        const RefGenListNode<ElemType>* p = hd->nextLink; // 第一个元素（P78：First/Next）
-        bool first = true;
-        while (p) {
-            if (!first) std::cout << ", ";
-            if (p->tag == ATOM) {
-                std::cout << p->atom;
-            } else if (p->tag == LIST) {
-                ShowHelp(p->subLink); // 递归显示子表
+    // —— 深度/长度缓存：任何一张表发生结构修改都会推进全局“修改纪元”，
+    //    因而共享子表被别处修改后，缓存也不会失效得不知不觉
+    mutable std::size_t cacheEpoch{0};
+    mutable int cachedDepth{0};
+    mutable int cachedLength{0};
+
+    static std::size_t& MutationEpoch() {
+        static std::size_t epoch = 1;
+        return epoch;
+    }
+    static void Touch() { ++MutationEpoch(); }
+
+    void RefreshCache() const {
+        if (cacheEpoch == MutationEpoch()) return;
+        cachedDepth = DepthHelp(head);
+        cachedLength = 0;
+        for (const Node* p = head->nextLink; p; p = p->nextLink) ++cachedLength;
+        cacheEpoch = MutationEpoch();
+    }
+
+    static Node* NewHead() {
+        Node* hd = new Node(HEAD);
+        hd->ref = 1;
+        hd->nextLink = nullptr;
+        return hd;
+    }
+
+    // —— 辅助：显示（P74），非递归：栈中为 (所在表头结点, 下一个待显示的元素)
+    static void ShowHelp(const RefGenListNode<ElemType>* hd, std::ostream& os) {
+        std::vector<std::pair<const Node*, const Node*>> st{{hd, hd->nextLink}};
+        os << "(";
+        while (!st.empty()) {
+            auto& [h, p] = st.back();
+            if (!p) { os << ")"; st.pop_back(); continue; }
+            if (p != h->nextLink) os << ", ";
+            const Node* cur = p;
+            p = p->nextLink;                       // 先前移，再可能压栈（压栈会使引用失效）
+            if (cur->tag == ATOM) {
+                os << cur->atom;
+            } else if (cur->tag == LIST) {
+                os << "(";
+                st.push_back({cur->subLink, cur->subLink->nextLink});
             }
-            first = false;
-            p = p->nextLink;
         }
-        std::cout << ")";
     }
 
-    // —— 辅助：深度计算（递归）（见 P79–P81）
-    int DepthHelp(const RefGenListNode<ElemType>* hd) const {
-        if (hd->nextLink == nullptr) return 1;   // 空表深度为 1（P80）
-        int subMax = 0;
-        for (const RefGenListNode<ElemType>* p = hd->nextLink; p; p = p->nextLink) {
-            if (p->tag == LIST) {
-                int d = DepthHelp(p->subLink);   // 子表深度
-                if (d > subMax) subMax = d;
+    // —— 辅助：深度计算（见 P79–P81），非递归 + 按子表头结点记忆化：
+    //    共享的子表只计算一次，时间与“不同结点数”成正比
+    static int DepthHelp(const RefGenListNode<ElemType>* hd) {
+        struct Frame { const Node* hd; const Node* p; int subMax; };
+        std::unordered_map<const Node*, int> memo;
+        std::vector<Frame> st{{hd, hd->nextLink, 0}};
+        int result = 1;
+        while (!st.empty()) {
+            Frame& f = st.back();
+            while (f.p) {
+                if (f.p->tag == LIST) {
+                    auto it = memo.find(f.p->subLink);
+                    if (it == memo.end()) break;   // 子表尚未求出，先下去算
+                    if (it->second > f.subMax) f.subMax = it->second;
+                }
+                f.p = f.p->nextLink;
             }
+            if (f.p) {
+                const Node* sub = f.p->subLink;
+                st.push_back({sub, sub->nextLink, 0});
+                continue;
+            }
+            result = f.subMax + 1;                 // 最大子表深度 + 1；空表为 1（P80–P81）
+            memo.emplace(f.hd, result);
+            st.pop_back();
         }
-        return subMax + 1;  // 最大子表深度 + 1（P81）
+        return result;
     }
 
-    // —— 辅助：释放（带引用计数，重要！）
+    // —— 辅助：释放（带引用计数，重要！），非递归：引用数归零的子表压入待释放栈
     static void ClearHelp(RefGenListNode<ElemType>* hd) {
         if (!hd) return;
-        // 释放同层元素链
-        RefGenListNode<ElemType>* p = hd->nextLink;
-        while (p) {
-            RefGenListNode<ElemType>* nxt = p->nextLink;
-            if (p->tag == LIST) {
-                // 引用计数 -1，若归零，递归释放子表（P69 引用数语义）
-                if (p->subLink) {
-                    p->subLink->ref--;
-                    if (p->subLink->ref <= 0) {
-                        ClearHelp(p->subLink);
-                        delete p->subLink;
-                    }
-                }
+        std::vector<Node*> pending;
+        Node* p = hd->nextLink;
+        hd->nextLink = nullptr;
+        for (;;) {
+            // 释放同层元素链
+            while (p) {
+                Node* nxt = p->nextLink;
+                if (p->tag == LIST && p->subLink && --p->subLink->ref <= 0)
+                    pending.push_back(p->subLink);  // P69 引用数语义：归零才释放子表
+                delete p;
+                p = nxt;
             }
-            delete p;
-            p = nxt;
+            if (pending.empty()) break;
+            Node* sub = pending.back();
+            pending.pop_back();
+            p = sub->nextLink;
+            delete sub;
         }
-        // 最后释放自身 HEAD
-        // 注意：此处不处理 hd->ref（由父调用/持有者控制）
+        // 注意：此处不处理 hd->ref，也不释放 hd 本身（由父调用/持有者控制）
+    }
+
+    // 持有者放弃一个引用：引用数归零才真正释放
+    static void ReleaseHead(RefGenListNode<ElemType>*& hd) {
+        if (!hd) return;
+        if (--hd->ref <= 0) { ClearHelp(hd); delete hd; }
+        hd = nullptr;
     }
 
-    // —— 辅助：深拷贝（将 sourceHead 拷贝成一个全新结构，P75）
+    // —— 辅助：深拷贝（将 sourceHead 拷贝成一个全新结构，P75），非递归；
+    //    源中共享的子表在副本中仍只复制一份（按源头结点建立映射）
     static void CopyHelp(const RefGenListNode<ElemType>* sourceHead,
                          RefGenListNode<ElemType>*& destHead) {
-        destHead = new RefGenListNode<ElemType>(HEAD);
-        destHead->ref = 1;               // 新建头结点引用数初始化为 1（P77）
-        destHead->nextLink = nullptr;
-
-        RefGenListNode<ElemType>* tail = nullptr; // 构造同层链的尾指针
-        for (const RefGenListNode<ElemType>* p = sourceHead->nextLink; p; p = p->nextLink) {
-            RefGenListNode<ElemType>* node = nullptr;
-            if (p->tag == ATOM) {
-                node = new RefGenListNode<ElemType>(ATOM);
-                node->atom = p->atom;
-            } else if (p->tag == LIST) {
-                node = new RefGenListNode<ElemType>(LIST);
-                // 递归复制子表（深拷贝）
-                RefGenListNode<ElemType>* newSubHead = nullptr;
-                CopyHelp(p->subLink, newSubHead);
-                node->subLink = newSubHead;
-                // 新子表被当前 LIST 结点引用，引用数+1（其自身构造时为1，当前引用再+1）
-                // 说明：我们采用“谁持有谁加 1”的策略，保证共享安全。
-                node->subLink->ref++;
-            }
-            node->nextLink = nullptr;
-
-            if (!tail) {
-                destHead->nextLink = node;
-                tail = node;
-            } else {
-                tail->nextLink = node;
+        std::unordered_map<const Node*, Node*> copied;
+        std::vector<std::pair<const Node*, Node*>> work;
+        auto headOf = [&](const Node* src) {
+            auto it = copied.find(src);
+            if (it != copied.end()) return it->second;
+            Node* h = new Node(HEAD);
+            h->ref = 0;                  // 引用数 = 指向它的 LIST 结点数（+ 持有者）
+            h->nextLink = nullptr;
+            copied.emplace(src, h);
+            work.push_back({src, h});
+            return h;
+        };
+        destHead = headOf(sourceHead);
+        destHead->ref = 1;               // 新建头结点由调用者持有（P77）
+        while (!work.empty()) {
+            auto [src, dst] = work.back();
+            work.pop_back();
+            Node* tail = nullptr;        // 构造同层链的尾指针
+            for (const Node* p = src->nextLink; p; p = p->nextLink) {
+                Node* node = new Node(p->tag);
+                if (p->tag == ATOM) {
+                    node->atom = p->atom;
+                } else if (p->tag == LIST) {
+                    node->subLink = headOf(p->subLink);
+                    node->subLink->ref++;    // “谁持有谁加 1”
+                }
+                node->nextLink = nullptr;
+                if (!tail) dst->nextLink = node; else tail->nextLink = node;
                 tail = node;
             }
         }
     }
 
-    //================= 解析器：从流创建广义表（实现 CreateHelp，P75） =================//
+    //================= 解析器：从字符串创建广义表（实现 CreateHelp，P75） =================//
+    //
+    // 文法：表 ::= '(' [ 元素 { ',' 元素 } ] ')'；元素 ::= 原子 | 表。
+    // 原子默认为一个非分隔符字符（面向 char，见课件示例）。
+    // 显式栈：frames[k] 收集第 k 层尚未闭合的表的元素；表闭合时整体建结点，
+    // 若 share 为真则先查哈希表，结构相同的子表直接复用（ref + 1）。
+
+    struct Item {
+        RefGenListNodeType tag;
+        ElemType atom;
+        Node* sub;                       // tag = LIST：已计入一个引用
+    };
 
-    // 跳过空白
-    static void skipSpaces(std::istream& is) {
-        while (std::isspace(is.peek())) is.get();
+    static std::size_t HashItems(const std::vector<Item>& items) {
+        std::size_t h = items.size();
+        for (const Item& it : items) {
+            std::size_t v = (it.tag == ATOM) ? std::hash<ElemType>()(it.atom)
+                                             : std::hash<const void*>()(it.sub);
+            h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2) + it.tag;
+        }
+        return h;
     }
 
-    // 解析原子：默认读取一个非分隔符字符作为 ElemType（面向 char，见课件示例）
-    static ElemType parseAtom(std::istream& is) {
-        skipSpaces(is);
-        int ch = is.get();
-        if (ch == EOF) throw std::runtime_error("解析原子失败：遇到 EOF。");
-        char c = static_cast<char>(ch);
-        if (c == '(' || c == ')' || c == ',' )
-            throw std::runtime_error(std::string("解析原子失败：意外的分隔符 '") + c + "'.");
-        // 若 ElemType 不是 char，可在此扩展为读取标识符/数字串等
-        return static_cast<ElemType>(c);
+    static bool SameItems(const Node* hd, const std::vector<Item>& items) {
+        const Node* p = hd->nextLink;
+        for (const Item& it : items) {
+            if (!p || p->tag != it.tag) return false;
+            if (it.tag == ATOM ? !(p->atom == it.atom) : p->subLink != it.sub) return false;
+            p = p->nextLink;
+        }
+        return p == nullptr;
     }
 
-    // 解析一个“元素”：ATOM 或 LIST
-    static RefGenListNode<ElemType>* parseElement(std::istream& is);
-
-    // 解析一个“列表”：形如 ( ... )
-    static RefGenListNode<ElemType>* parseList(std::istream& is) {
-        skipSpaces(is);
-        if (is.get() != '(') throw std::runtime_error("缺少 '(' 开始列表。");
-
-        auto* hd = new RefGenListNode<ElemType>(HEAD);
-        hd->ref = 1;            // 新建子表头结点，引用数从 1 开始（P77）
+    static Node* BuildHead(const std::vector<Item>& items) {
+        Node* hd = new Node(HEAD);
+        hd->ref = 0;
         hd->nextLink = nullptr;
-
-        skipSpaces(is);
-        if (is.peek() == ')') { // 空表（P63 定义）
-            is.get();           // 吃掉 ')'
-            return hd;
-        }
-
-        RefGenListNode<ElemType>* tail = nullptr;
-        while (true) {
-            RefGenListNode<ElemType>* elem = parseElement(is);
-            if (!tail) { hd->nextLink = elem; tail = elem; }
-            else { tail->nextLink = elem; tail = elem; }
-
-            skipSpaces(is);
-            int ch = is.peek();
-            if (ch == ',') { is.get(); continue; }   // 还有后续元素
-            else if (ch == ')') { is.get(); break; } // 列表结束
-            else throw std::runtime_error("列表元素之间缺少 ',' 或 右括号 ')'");
+        Node* tail = nullptr;
+        for (const Item& it : items) {
+            Node* node = new Node(it.tag);
+            if (it.tag == ATOM) node->atom = it.atom;
+            else node->subLink = it.sub; // 引用由 Item 转交给 LIST 结点
+            node->nextLink = nullptr;
+            if (!tail) hd->nextLink = node; else tail->nextLink = node;
+            tail = node;
         }
         return hd;
     }
 
-    // parseElement 需要 parseList 的声明后才能定义
-    // 放在类外 inline 定义（见后）
+    static bool IsSpace(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+    static RefGenListNode<ElemType>* ParseHelp(std::string_view s, bool share) {
+        std::vector<std::vector<Item>> frames;   // 各层向量留着复用，避免反复申请
+        std::size_t depth = 0;
+        std::unordered_multimap<std::size_t, Node*> interned;
+        enum { OPENED, AFTER_ELEM, AFTER_COMMA } state = OPENED;
+        Node* result = nullptr;
+        std::size_t i = 0;
+
+        auto fail = [&](const std::string& msg) {
+            throw std::runtime_error(msg + "（位置 " + std::to_string(i) + "）");
+        };
+        try {
+            while (i < s.size() && IsSpace(s[i])) ++i;
+            if (i == s.size() || s[i] != '(') fail("缺少 '(' 开始列表。");
+            for (; i < s.size() && !result; ++i) {
+                char c = s[i];
+                if (IsSpace(c)) continue;
+                if (c == '(') {
+                    if (depth > 0 && state == AFTER_ELEM) fail("列表元素之间缺少 ',' 或 右括号 ')'");
+                    if (frames.size() == depth) frames.emplace_back();
+                    frames[depth++].clear();
+                    state = OPENED;
+                } else if (c == ')') {
+                    if (state == AFTER_COMMA) fail("解析原子失败：意外的分隔符 ')'.");
+                    std::vector<Item>& items = frames[--depth];
+                    Node* hd = nullptr;
+                    if (depth == 0) {
+                        hd = BuildHead(items);  // 最外层表归调用者所有，不参与合并
+                        hd->ref = 1;
+                        items.clear();
+                        result = hd;
+                        continue;               // ++i 后因 result 非空退出循环
+                    }
+                    if (share) {
+                        std::size_t h = HashItems(items);
+                        auto range = interned.equal_range(h);
+                        for (auto it = range.first; it != range.second; ++it)
+                            if (SameItems(it->second, items)) { hd = it->second; break; }
+                        if (hd) {
+                            // 复用已有子表：本层 Item 持有的引用全部归还
+                            for (Item& it : items)
+                                if (it.tag == LIST) --it.sub->ref;  // 已被 hd 共享，不会归零
+                        } else {
+                            hd = BuildHead(items);
+                            interned.emplace(h, hd);
+                        }
+                    } else {
+                        hd = BuildHead(items);
+                    }
+                    items.clear();
+                    hd->ref++;
+                    frames[depth - 1].push_back(Item{LIST, ElemType(), hd});
+                    state = AFTER_ELEM;
+                } else if (c == ',') {
+                    if (state != AFTER_ELEM) fail("解析原子失败：意外的分隔符 ','.");
+                    state = AFTER_COMMA;
+                } else {
+                    if (state == AFTER_ELEM) fail("列表元素之间缺少 ',' 或 右括号 ')'");
+                    // 若 ElemType 不是 char，可在此扩展为读取标识符/数字串等
+                    frames[depth - 1].push_back(Item{ATOM, static_cast<ElemType>(c), nullptr});
+                    state = AFTER_ELEM;
+                }
+            }
+            if (!result) fail("列表未闭合：缺少右括号 ')'");
+            for (; i < s.size(); ++i)
+                if (!IsSpace(s[i])) fail("列表结束后有多余字符");
+        } catch (...) {
+            // 出错时归还所有未闭合层上 Item 持有的引用，已建成的子表随之释放
+            for (std::size_t k = 0; k < depth; ++k)
+                for (Item& it : frames[k])
+                    if (it.tag == LIST) ReleaseHead(it.sub);
+            ReleaseHead(result);
+            throw;
+        }
+        return result;
+    }
 
 public:
     //================== 构造 / 析构 / 复制 / 赋值（P75–P77） ==================//
 
     // 无参构造：创建空表（只有 HEAD，nextLink=null）（P77）
     RefGenList() {
-        head = new RefGenListNode<ElemType>(HEAD);
-        head->ref = 1;
-        head->nextLink = nullptr;
+        head = NewHead();
     }
 
     // 由头结点构造：共享已有结构（引用数+1）
     explicit RefGenList(RefGenListNode<ElemType>* hd) : head(hd) {
         if (!head) {
-            head = new RefGenListNode<ElemType>(HEAD);
-            head->ref = 1;
-            head->nextLink = nullptr;
+            head = NewHead();
         } else {
             head->ref++;  // 新增一个拥有者（P69）
         }
@@ -225,16 +428,15 @@ public:
         CopyHelp(src.head, head);
     }
 
+    // 移动构造：接管源的头结点，源变为空表
+    RefGenList(RefGenList&& src) : head(src.head) {
+        src.head = NewHead();
+        Touch();
+    }
+
     // 析构：释放一切拥有的引用
     ~RefGenList() {
-        if (head) {
-            head->ref--;
-            if (head->ref <= 0) {
-                ClearHelp(head);
-                delete head;
-            }
-            head = nullptr;
-        }
+        ReleaseHead(head);
     }
 
     // 赋值：强异常安全的“拷贝-再交换”
@@ -242,12 +444,16 @@ public:
         if (this == &src) return *this;
         RefGenListNode<ElemType>* newHead = nullptr;
         CopyHelp(src.head, newHead);
-        // 释放旧的
-        if (head) {
-            head->ref--;
-            if (head->ref <= 0) { ClearHelp(head); delete head; }
-        }
+        ReleaseHead(head);   // 释放旧的
         head = newHead;
+        Touch();
+        return *this;
+    }
+
+    RefGenList& operator=(RefGenList&& src) {
+        if (this == &src) return *this;
+        std::swap(head, src.head);
+        Touch();
         return *this;
     }
 
@@ -270,6 +476,7 @@ public:
         node->atom = e;
         node->nextLink = head->nextLink;
         head->nextLink = node;
+        Touch();
     }
 
     // (5) 头插一个子表 subList（共享其头结点，引用数 +1）（P67、P76）
@@ -279,66 +486,57 @@ public:
         node->subLink->ref++;               // 增加对子表的一个引用（P69）
         node->nextLink = head->nextLink;
         head->nextLink = node;
+        Touch();
     }
 
-    // (6) 深度（P79–P81）
-    int Depth() { return DepthHelp(head); }
+    // (6) 深度（P79–P81）；结构未变时重复查询 O(1)
+    int Depth() const { RefreshCache(); return cachedDepth; }
+
+    // （扩展）长度：最外层元素个数（P63）
+    int Length() const { RefreshCache(); return cachedLength; }
+
+    // （扩展）可达的不同结点数（HEAD/ATOM/LIST 合计），用来观察哈希合并的共享效果
+    std::size_t NodeCount() const {
+        std::unordered_set<const Node*> seen{head};
+        std::vector<const Node*> st{head};
+        std::size_t cnt = 0;
+        while (!st.empty()) {
+            const Node* h = st.back();
+            st.pop_back();
+            ++cnt;
+            for (const Node* p = h->nextLink; p; p = p->nextLink) {
+                ++cnt;
+                if (p->tag == LIST && seen.insert(p->subLink).second) st.push_back(p->subLink);
+            }
+        }
+        return cnt;
+    }
 
     // （扩展）显示：形如 (a, (b, c), d)（P74）
-    void Show() const { ShowHelp(head); }
+    void Show(std::ostream& os = std::cout) const { ShowHelp(head, os); }
 
     // 输入：从一行字符串解析创建广义表（P75 “CreateHelp”思想）
     // 说明：为教学简化，默认按 char 原子解析：遇到 '(', ')' 和 ',' 以外的单个字符视为原子。
     void Input() {
         std::string line;
         std::getline(std::cin, line);
-        std::istringstream iss(line);
-        RefGenListNode<ElemType>* newHead = parseList(iss);
-
-        // 释放旧的
-        if (head) {
-            head->ref--;
-            if (head->ref <= 0) { ClearHelp(head); delete head; }
-        }
+        RefGenListNode<ElemType>* newHead = ParseHelp(line, true);
+        ReleaseHead(head);   // 释放旧的
         head = newHead;
+        Touch();
     }
 
-    // 工厂：从字符串直接生成（便于示例/单元测试）
-    static RefGenList FromString(const std::string& s) {
-        std::istringstream iss(s);
+    // 工厂：从字符串直接生成（便于示例/单元测试）。
+    // share 为真时结构相同的子表只存一份（哈希合并）；此时这些子表被多处引用，
+    // 应视为只读——经 First()->subLink 取出再 Push 会同时影响所有引用处（P65 共享性）。
+    static RefGenList FromString(std::string_view s, bool share = true) {
         RefGenList gl;
-        // 先释放默认空表
-        gl.head->ref--;
-        if (gl.head->ref <= 0) { ClearHelp(gl.head); delete gl.head; }
-        gl.head = parseList(iss); // 接管新表
+        ReleaseHead(gl.head);          // 先释放默认空表
+        gl.head = ParseHelp(s, share); // 接管新表
         return gl;
     }
 };
 
-// —— 解析元素：要么原子，要么子表
-template <class ElemType>
-RefGenListNode<ElemType>* RefGenList<ElemType>::parseElement(std::istream& is) {
-    skipSpaces(is);
-    int ch = is.peek();
-    if (ch == '(') {
-        // 子表
-        auto* subHead = parseList(is);
-        auto* node = new RefGenListNode<ElemType>(LIST);
-        node->subLink = subHead;         // 当前 LIST 结点持有子表
-        // 当前 LIST 作为一个“新引用”，将子表 head 的 ref +1（P69）
-        node->subLink->ref++;
-        node->nextLink = nullptr;
-        return node;
-    } else {
-        // 原子
-        ElemType v = parseAtom(is);
-        auto* node = new RefGenListNode<ElemType>(ATOM);
-        node->atom = v;
-        node->nextLink = nullptr;
-        return node;
-    }
-}
-
 //============================== 演示（P73、P79） ==============================//
 
 /*
@@ -381,6 +579,36 @@ int main() {
     std::cout << "B.Next(First)->value = "
               << (secondOfB && secondOfB->tag==ATOM ? secondOfB->atom : '#') << "\n";
 
+    // （扩展）哈希合并：三个相同的子表 (a, b) 只存一份
+    GL E  = GL::FromString("((a, b), (a, b), ((a, b)))");
+    GL E2 = GL::FromString("((a, b), (a, b), ((a, b)))", /*share=*/false);
+    std::cout << "E = "; E.Show(); std::cout << ", Depth = " << E.Depth()
+              << ", Length = " << E.Length() << ", 结点数 " << E.NodeCount()
+              << "（不合并 " << E2.NodeCount() << "）\n";
+
+    // （扩展）大规模输入：嵌套 100 万层的表，以及 10 万个重复子表拼成的宽表
+    {
+        const int depth = 1000000, width = 100000;
+        std::string deep(depth, '(');
+        deep += 'a';
+        deep += std::string(depth, ')');
+        std::string wide = "(";
+        for (int i = 0; i < width; ++i) wide += (i ? ",(x,(y,z))" : "(x,(y,z))");
+        wide += ")";
+
+        auto t0 = std::chrono::steady_clock::now();
+        GL deepGL = GL::FromString(deep);
+        auto t1 = std::chrono::steady_clock::now();
+        GL wideGL = GL::FromString(wide);
+        auto t2 = std::chrono::steady_clock::now();
+        auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+        std::cout << "嵌套 " << depth << " 层：Depth = " << deepGL.Depth()
+                  << "，解析 " << ms(t0, t1) << " ms\n";
+        std::cout << "宽表 " << width << " 个重复子表：Length = " << wideGL.Length()
+                  << "，Depth = " << wideGL.Depth() << "，结点数 " << wideGL.NodeCount()
+                  << "，解析 " << ms(t1, t2) << " ms\n";
+    }
+
     // Input（从标准输入读取一行进行解析，示例： (a, (b, c), d) ）
     std::cout << "\n请输入一个广义表（示例：(a,(b,c),d)）：\n> ";
     GL userGL;
@@ -4,6 +4,8 @@
 // 本文件实现：
 //   1) 冒泡排序 BubbleSort（9.3.1，课件第30-33页）
 //   2) 快速排序 QuickSort + Partition（9.3.2，课件第35-38页）
+//   3) 工程化快速排序 IntroQuickSort（三者/九者取中 + 深度上限转堆排序 + 小区间插入排序）
+//      与任务并行版 ParallelQuickSort（工作窃取线程池 WorkStealingPool）
 //
 // 交换类排序的思想：通过“交换”无序序列中的元素，使某个极值元素进入有序区，逐步扩大有序区（课件第9页）。
 //
@@ -12,7 +14,7 @@
 //   - 快速排序不稳定（课件第78-79页）
 //
 // 编译运行（示例）：
-//   g++ -std=c++17 -O2 -Wall 交换排序.cpp -o exchange_sort
+//   g++ -std=c++17 -O2 -Wall -pthread 交换排序.cpp -o exchange_sort
 //   ./exchange_sort
 // 输入格式：
 //   n
@@ -23,6 +25,16 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
 
 template <class ElemType>
 void PrintArray(const ElemType elem[], int n, const std::string& title) {
@@ -100,6 +112,350 @@ void QuickSort(ElemType elem[], int n) {
     QuickSort(elem, 0, n - 1);
 }
 
+// ============================================================
+// 9.3.2（续）快速排序的工程化版本：IntroQuickSort / ParallelQuickSort
+// ------------------------------------------------------------
+// 课件第78-79页指出：快速排序平均 O(nlogn)，但最坏情况（初始序列有序或基本有序）退化为 O(n^2)，
+// 且递归深度可达 n。上面的 QuickSort 固定以 elem[low] 为支点、不限递归深度，
+// 有序输入上既慢又可能栈溢出。下面给出一个可用于实际数据的版本（即常说的 introsort）：
+//   1) 支点：小区间用“三者取中”(median-of-three)，大区间用“九者取中”(ninther)，
+//      有序/逆序输入也能得到接近中位数的支点；
+//   2) 划分：双指针 Hoare 划分，遇到与支点相等的元素两侧都停下交换，
+//      大量重复关键字时仍能均分（课件的挖坑写法在全部相等时会退化为一边倒）；
+//   3) 深度上限 2*floor(log2 n)：超过即说明支点选择持续失败，改用堆排序（9.4.2）保证 O(nlogn)；
+//   4) 小区间（<= kQuickSortCutoff）直接插入排序（9.2.1），省去递归开销；
+//   5) 只对较短的一段递归、较长的一段循环处理，栈深度不超过 O(logn)。
+//
+// 说明：本目录每个 .cpp 都独立编译，因此区间版的直接插入排序与堆排序在这里各保留一份，
+// 算法与 插入排序.cpp 的 StraightInsertSort、选择排序.cpp 的 SiftDown/HeapSort 完全一致。
+// ============================================================
+const int kQuickSortCutoff = 24;
+
+// 对 elem[low..high] 做直接插入排序（同 StraightInsertSort，课件第21页）
+template <class ElemType>
+void InsertSortRange(ElemType elem[], int low, int high) {
+    for (int i = low + 1; i <= high; ++i) {
+        ElemType e = elem[i];
+        int j;
+        for (j = i - 1; j >= low && e < elem[j]; --j) {
+            elem[j + 1] = elem[j];
+        }
+        elem[j + 1] = e;
+    }
+}
+
+// 对 elem[low..high] 做堆排序（同 SiftDown/HeapSort，课件第45-51页）
+template <class ElemType>
+void HeapSortRange(ElemType elem[], int low, int high) {
+    ElemType* base = elem + low;
+    int n = high - low + 1;
+    auto siftDown = [base](int root, int end) {
+        while (true) {
+            int child = root * 2 + 1;
+            if (child > end) break;
+            if (child + 1 <= end && base[child] < base[child + 1]) child++;
+            if (!(base[root] < base[child])) break;
+            std::swap(base[root], base[child]);
+            root = child;
+        }
+    };
+    for (int i = (n - 2) / 2; i >= 0; --i) siftDown(i, n - 1);
+    for (int end = n - 1; end > 0; --end) {
+        std::swap(base[0], base[end]);
+        siftDown(0, end - 1);
+    }
+}
+
+// 返回 elem[a], elem[b], elem[c] 中关键字居中者的下标
+template <class ElemType>
+int MedianOfThree(const ElemType elem[], int a, int b, int c) {
+    if (elem[a] < elem[b]) {
+        if (elem[b] < elem[c]) return b;
+        return elem[a] < elem[c] ? c : a;
+    }
+    if (elem[a] < elem[c]) return a;
+    return elem[b] < elem[c] ? c : b;
+}
+
+// 选支点：长度 >= 128 时取“九者取中”（三组三者取中后再取中），否则三者取中
+template <class ElemType>
+int ChoosePivot(const ElemType elem[], int low, int high) {
+    int len = high - low + 1;
+    int mid = low + len / 2;
+    if (len >= 128) {
+        int step = len / 8;
+        int a = MedianOfThree(elem, low, low + step, low + 2 * step);
+        int b = MedianOfThree(elem, mid - step, mid, mid + step);
+        int c = MedianOfThree(elem, high - 2 * step, high - step, high);
+        return MedianOfThree(elem, a, b, c);
+    }
+    return MedianOfThree(elem, low, mid, high);
+}
+
+// Hoare 划分：把选出的支点换到 elem[low]，返回支点最终位置 i，
+// 满足 elem[low..i-1] <= elem[i] <= elem[i+1..high]（与课件第35页 Partition 的约定相同）
+template <class ElemType>
+int PartitionHoare(ElemType elem[], int low, int high) {
+    std::swap(elem[low], elem[ChoosePivot(elem, low, high)]);
+    const ElemType pivot = elem[low];
+    int i = low, j = high + 1;
+    while (true) {
+        while (elem[++i] < pivot) {
+            if (i == high) break;
+        }
+        while (pivot < elem[--j]) {}   // elem[low] == pivot 充当左侧哨兵
+        if (i >= j) break;
+        std::swap(elem[i], elem[j]);
+    }
+    std::swap(elem[low], elem[j]);
+    return j;
+}
+
+// introsort 主循环：对 elem[low..high] 排序，depthLimit 为剩余允许的划分层数
+template <class ElemType>
+void IntroSortLoop(ElemType elem[], int low, int high, int depthLimit) {
+    while (high - low + 1 > kQuickSortCutoff) {
+        if (depthLimit == 0) {          // 支点连续选坏：改用堆排序兜底
+            HeapSortRange(elem, low, high);
+            return;
+        }
+        --depthLimit;
+        int p = PartitionHoare(elem, low, high);
+        // 较短一段递归，较长一段就地循环，保证栈深 O(logn)
+        if (p - low < high - p) {
+            IntroSortLoop(elem, low, p - 1, depthLimit);
+            low = p + 1;
+        } else {
+            IntroSortLoop(elem, p + 1, high, depthLimit);
+            high = p - 1;
+        }
+    }
+    InsertSortRange(elem, low, high);
+}
+
+inline int IntroDepthLimit(int n) {
+    int lg = 0;
+    while ((1 << (lg + 1)) <= n && lg < 30) ++lg;
+    return 2 * lg;
+}
+
+template <class ElemType>
+void IntroQuickSort(ElemType elem[], int n) {
+    if (n <= 1) return;
+    IntroSortLoop(elem, 0, n - 1, IntroDepthLimit(n));
+}
+
+// ============================================================
+// 任务并行的快速排序
+// ------------------------------------------------------------
+// 一次划分之后左右两段互不相交，可以交给不同线程各自排序。
+// 线程池采用“工作窃取”(work stealing)：每个工作线程有自己的双端队列，
+// 新任务压入自己队列的尾部并优先从尾部取（刚切出来的子区间还在缓存里），
+// 自己的队列空了再从别的线程队列头部“偷”一个（头部通常是更大的区间，偷一次能干很久）。
+// 大区间（> grain）划分后把一段作为新任务提交、另一段自己继续；
+// 区间降到 grain 以下就在当前线程内串行 IntroSortLoop，避免任务过碎。
+// ============================================================
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < threads; ++i) queues_.emplace_back(new WorkQueue);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lk(sleepMutex_);
+            stop_ = true;
+        }
+        sleepCv_.notify_all();
+        for (std::thread& w : workers_) w.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // 提交任务：在工作线程内调用则压入自己的队列，否则轮流分给各队列
+    void submit(Task task) {
+        unsigned target;
+        if (currentPool() == this) target = currentIndex();
+        else target = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lk(queues_[target]->m);
+            queues_[target]->q.push_back(std::move(task));
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        { std::lock_guard<std::mutex> lk(sleepMutex_); }
+        sleepCv_.notify_one();
+    }
+
+    // 等待所有已提交（以及由它们派生）的任务完成；调用线程在等待期间也帮忙执行任务
+    void wait() {
+        Task task;
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (trySteal(0, task)) runTask(task);
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex m;
+        std::deque<Task> q;
+    };
+
+    static WorkStealingPool*& currentPool() {
+        static thread_local WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+    static unsigned& currentIndex() {
+        static thread_local unsigned index = 0;
+        return index;
+    }
+
+    bool tryPopLocal(unsigned self, Task& task) {
+        WorkQueue& wq = *queues_[self];
+        std::lock_guard<std::mutex> lk(wq.m);
+        if (wq.q.empty()) return false;
+        task = std::move(wq.q.back());
+        wq.q.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 从 start 开始轮询其他队列，从头部偷一个任务
+    bool trySteal(unsigned start, Task& task) {
+        for (std::size_t k = 0; k < queues_.size(); ++k) {
+            WorkQueue& wq = *queues_[(start + k) % queues_.size()];
+            std::lock_guard<std::mutex> lk(wq.m);
+            if (wq.q.empty()) continue;
+            task = std::move(wq.q.front());
+            wq.q.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void runTask(Task& task) {
+        task();
+        task = nullptr;
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void workerLoop(unsigned self) {
+        currentPool() = this;
+        currentIndex() = self;
+        Task task;
+        while (true) {
+            if (tryPopLocal(self, task) || trySteal(self + 1, task)) {
+                runTask(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(sleepMutex_);
+            sleepCv_.wait(lk, [this]() {
+                return stop_ || queued_.load(std::memory_order_acquire) > 0;
+            });
+            if (stop_ && queued_.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<long> pending_{0};     // 已提交但未执行完的任务数
+    std::atomic<long> queued_{0};      // 仍在队列中等待的任务数
+    std::atomic<unsigned> nextQueue_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    bool stop_ = false;
+};
+
+template <class ElemType>
+void ParallelQuickSortTask(WorkStealingPool& pool, ElemType elem[], int low, int high,
+                           int depthLimit, int grain) {
+    while (high - low + 1 > grain) {
+        if (depthLimit == 0) {
+            HeapSortRange(elem, low, high);
+            return;
+        }
+        --depthLimit;
+        int p = PartitionHoare(elem, low, high);
+        // 较短一段交给线程池（可能被其他线程偷走），较长一段留在本线程继续划分
+        int sl, sh;
+        if (p - low < high - p) { sl = low; sh = p - 1; low = p + 1; }
+        else                    { sl = p + 1; sh = high; high = p - 1; }
+        pool.submit([&pool, elem, sl, sh, depthLimit, grain]() {
+            ParallelQuickSortTask(pool, elem, sl, sh, depthLimit, grain);
+        });
+    }
+    IntroSortLoop(elem, low, high, depthLimit);
+}
+
+// 参数：
+//   threads - 线程数，0 表示使用 hardware_concurrency()
+//   grain   - 区间长度不超过 grain 时不再拆分任务，直接串行排序
+template <class ElemType>
+void ParallelQuickSort(ElemType elem[], int n, unsigned threads = 0, int grain = 1 << 14) {
+    if (n <= 1) return;
+    if (grain < kQuickSortCutoff) grain = kQuickSortCutoff;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1 || n <= grain) {
+        IntroQuickSort(elem, n);
+        return;
+    }
+    WorkStealingPool pool(threads);
+    int depthLimit = IntroDepthLimit(n);
+    pool.submit([&pool, elem, n, depthLimit, grain]() {
+        ParallelQuickSortTask(pool, elem, 0, n - 1, depthLimit, grain);
+    });
+    pool.wait();
+}
+
+// 在有序 / 逆序 / 全相同 / 随机四种输入上比较 IntroQuickSort、ParallelQuickSort 与 std::sort，
+// 并校验结果一致（课件 QuickSort 在前三种输入上是 O(n^2)，大规模时不参与比较）
+void BenchmarkQuickSort(int n, unsigned threads) {
+    std::mt19937 rng(2024);
+    const char* names[] = {"random", "sorted", "reverse", "all-equal"};
+    for (int kind = 0; kind < 4; ++kind) {
+        std::vector<int> base(n);
+        for (int i = 0; i < n; ++i) {
+            switch (kind) {
+                case 0: base[i] = static_cast<int>(rng()); break;
+                case 1: base[i] = i; break;
+                case 2: base[i] = n - i; break;
+                default: base[i] = 7; break;
+            }
+        }
+        std::vector<int> expect = base;
+        auto t0 = std::chrono::steady_clock::now();
+        std::sort(expect.begin(), expect.end());
+        auto t1 = std::chrono::steady_clock::now();
+        std::vector<int> x = base;
+        IntroQuickSort(x.data(), n);
+        auto t2 = std::chrono::steady_clock::now();
+        std::vector<int> y = base;
+        ParallelQuickSort(y.data(), n, threads);
+        auto t3 = std::chrono::steady_clock::now();
+
+        auto ms = [](std::chrono::steady_clock::duration d) {
+            return std::chrono::duration<double, std::milli>(d).count();
+        };
+        std::cout << "  " << names[kind] << ": std::sort " << ms(t1 - t0)
+                  << " ms, IntroQuickSort " << ms(t2 - t1)
+                  << " ms, ParallelQuickSort(" << threads << " threads) " << ms(t3 - t2) << " ms"
+                  << ((x == expect && y == expect) ? "" : "  [MISMATCH]") << "\n";
+    }
+}
+
+// 定义 SORT_BENCHMARK_NO_MAIN 时不编译演示 main，供 排序性能测试.cpp 直接包含本文件
+#ifndef SORT_BENCHMARK_NO_MAIN
 int main() {
     int n;
     std::cout << "Input n and n integers:\n";
@@ -117,5 +473,17 @@ int main() {
     QuickSort(c.data(), n);
     PrintArray(c.data(), n, "[QuickSort] (课件 9.3.2 第35-38页)");
 
+    std::vector<int> d = a;
+    IntroQuickSort(d.data(), n);
+    PrintArray(d.data(), n, "[IntroQuickSort] (9.3.2 续：取中支点 + 堆排序兜底 + 插入排序收尾)");
+
+    std::vector<int> e = a;
+    ParallelQuickSort(e.data(), n, 0, kQuickSortCutoff);
+    PrintArray(e.data(), n, "[ParallelQuickSort] (工作窃取线程池)");
+
+    std::cout << "[Benchmark] n = " << (1 << 22) << "\n";
+    BenchmarkQuickSort(1 << 22, std::max(2u, std::thread::hardware_concurrency()));
+
     return 0;
 }
+#endif
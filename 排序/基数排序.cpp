@@ -3,6 +3,8 @@
 // 依据课件《Ch09 排序 2024》（孙奕髦，四川大学）编写的配套示例代码。
 // 本文件实现：
 //   - LSD（最低位优先）“链式基数排序”（9.6，课件第62-71页）
+//   - 基于计数的数组基数排序 RadixSortCounting / RadixSortBy（8/11/16 位一趟、ping-pong 缓冲，
+//     支持有符号整数、浮点数与按关键字提取函数排序记录）及多线程版 ParallelRadixSort
 //
 // 课件要点：
 //   1) 基数排序是一种借助“多关键字排序”思想来实现“单关键字排序”的内部排序算法（课件第62页）
@@ -17,7 +19,7 @@
 //   - 稳定：因为“分配”到桶链表时采用尾插，保证同一桶内相对次序不变（对应课件第76页稳定性定义、第79页“基数排序稳定”）
 //
 // 编译运行（示例）：
-//   g++ -std=c++17 -O2 -Wall 基数排序.cpp -o radix_sort
+//   g++ -std=c++17 -O2 -Wall -pthread 基数排序.cpp -o radix_sort
 //   ./radix_sort
 // 输入格式：
 //   n
@@ -29,6 +31,14 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
 
 struct Node {
     int key;
@@ -131,11 +141,260 @@ void RadixSortLSD(int a[], int n, int radix = 10) {
     FreeList(head);
 }
 
+// ============================================================
+// 9.6（续）基于计数的数组基数排序
+// ------------------------------------------------------------
+// 上面的链式实现忠实对应课件的“分配-收集”，但每个元素 new 一个结点、每趟做一次 / 和 %、
+// 收集时顺着指针跳来跳去，数据量一大就比比较排序还慢，而且只能排非负整数。
+// 工程上常用的做法把“链表 + 桶”换成“计数 + 前缀和 + 数组搬运”，思想仍是课件的 LSD 分配-收集：
+//   1) 基取 2 的幂 r = 2^b（b = 8/11/16），取第 k 位只需 (key >> (k*b)) & (r-1)，没有除法；
+//   2) 分配：先统计每个桶的元素个数 count[]（一次遍历就能把所有趟的直方图都统计出来）；
+//   3) 收集：对 count[] 求前缀和得到每个桶在输出数组中的起点，再按原次序把元素搬过去
+//      （同桶内按原次序写入，与链式实现的“尾插”一样保证稳定）；
+//   4) 两块数组交替作为输入/输出（ping-pong），整个排序只额外申请一块 n 大小的缓冲区；
+//   5) 若某一趟所有元素落在同一个桶（例如小整数的高位全为 0），这一趟直接跳过。
+//
+// 有符号整数与浮点数通过“关键字变换”映射成无符号整数，使无符号序与原数值序一致：
+//   - 有符号整数：翻转符号位（负数变小、非负数变大）；
+//   - IEEE-754 浮点：正数翻转符号位，负数按位取反（负数绝对值越大，变换后越小）。
+// ============================================================
+template <class Key, class Enable = void>
+struct RadixKeyTraits;
+
+// 无符号整数：本身即可
+template <class Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                                   std::is_unsigned<Key>::value>::type> {
+    using Unsigned = Key;
+    static Unsigned toUnsigned(Key k) { return k; }
+};
+
+// 有符号整数：翻转符号位
+template <class Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                                   std::is_signed<Key>::value>::type> {
+    using Unsigned = typename std::make_unsigned<Key>::type;
+    static Unsigned toUnsigned(Key k) {
+        return static_cast<Unsigned>(k) ^ (Unsigned(1) << (sizeof(Key) * 8 - 1));
+    }
+};
+
+// 浮点数：按位重解释后，正数翻转符号位，负数全部取反（NaN 排在正无穷之后或负无穷之前）
+template <class Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type> {
+    static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "only float/double are supported");
+    using Unsigned = typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type;
+    static Unsigned toUnsigned(Key k) {
+        Unsigned bits;
+        std::memcpy(&bits, &k, sizeof(bits));
+        const Unsigned sign = Unsigned(1) << (sizeof(Key) * 8 - 1);
+        return (bits & sign) ? ~bits : (bits ^ sign);
+    }
+};
+
+// 取出关键字的无符号形式：key(elem) 可以返回任意整数或浮点类型
+template <class Record, class KeyFn>
+struct RadixKeyOf {
+    using Key = typename std::decay<decltype(std::declval<KeyFn&>()(std::declval<const Record&>()))>::type;
+    using Traits = RadixKeyTraits<Key>;
+    using Unsigned = typename Traits::Unsigned;
+};
+
+inline void CheckDigitBits(int digitBits) {
+    if (digitBits != 8 && digitBits != 11 && digitBits != 16)
+        throw std::invalid_argument("digitBits must be 8, 11 or 16");
+}
+
+// ------------------------------------------------------------
+// RadixSortBy：按 key(elem) 对记录数组做稳定的 LSD 基数排序
+//   a[]       - 待排序记录（须可默认构造——辅助数组按 n 个元素构造——且可移动赋值）
+//   key       - 关键字提取函数，返回整数或浮点
+//   digitBits - 每趟处理的二进制位数 b（基 r = 2^b）：
+//               8 位直方图只有 256 项，始终留在 L1；11 位对 32 位关键字正好 3 趟；
+//               16 位趟数最少，但 65536 项直方图只在 n 很大时才划算
+// ------------------------------------------------------------
+template <class Record, class KeyFn>
+void RadixSortBy(Record a[], int n, KeyFn key, int digitBits = 8) {
+    using KeyOf = RadixKeyOf<Record, KeyFn>;
+    using Unsigned = typename KeyOf::Unsigned;
+    CheckDigitBits(digitBits);
+    if (n <= 1) return;
+
+    const int keyBits = static_cast<int>(sizeof(Unsigned) * 8);
+    const int passes = (keyBits + digitBits - 1) / digitBits;
+    const std::size_t radix = std::size_t(1) << digitBits;
+    const Unsigned mask = static_cast<Unsigned>(radix - 1);
+
+    // 1) 一次遍历统计所有趟的直方图
+    std::vector<std::size_t> count(passes * radix, 0);
+    for (int i = 0; i < n; ++i) {
+        Unsigned k = KeyOf::Traits::toUnsigned(key(a[i]));
+        for (int p = 0; p < passes; ++p) ++count[p * radix + ((k >> (p * digitBits)) & mask)];
+    }
+
+    // 2) 逐趟：前缀和定位 + 稳定搬运，两块数组交替使用
+    std::vector<Record> buffer(n);
+    Record* src = a;
+    Record* dst = buffer.data();
+    for (int p = 0; p < passes; ++p) {
+        std::size_t* c = &count[p * radix];
+        Unsigned k0 = KeyOf::Traits::toUnsigned(key(src[0]));
+        if (c[(k0 >> (p * digitBits)) & mask] == static_cast<std::size_t>(n)) continue;  // 本趟只有一个桶
+
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < radix; ++d) {
+            std::size_t t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        const int shift = p * digitBits;
+        for (int i = 0; i < n; ++i) {
+            Unsigned k = KeyOf::Traits::toUnsigned(key(src[i]));
+            dst[c[(k >> shift) & mask]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+    if (src != a) std::move(src, src + n, a);
+}
+
+// 整数 / 浮点数组：关键字就是元素本身
+template <class Key>
+void RadixSortCounting(Key a[], int n, int digitBits = 8) {
+    RadixSortBy(a, n, [](const Key& k) { return k; }, digitBits);
+}
+
+// ============================================================
+// 多线程版本：每个线程负责一段连续区间
+// ------------------------------------------------------------
+// 每一趟分两步（两步之间各线程同步一次）：
+//   1) 各线程统计自己区间的直方图 count[t][d]；
+//   2) 按“桶号优先、线程号其次”求前缀和：线程 t 在桶 d 的起点 =
+//        (所有线程桶 < d 的元素总数) + (线程 0..t-1 在桶 d 中的元素数)，
+//      于是各线程可以互不加锁地把自己区间搬到输出数组，且同桶内仍保持原次序（稳定）。
+// 每个线程的直方图单独占一段、长度补齐到 128 字节的整数倍，大部分计数器不会与其它线程
+// 落在同一缓存行；起点未按缓存行对齐，相邻两段至多在交界处共享一条缓存行（伪共享）。
+// ============================================================
+template <class Record, class KeyFn>
+void ParallelRadixSortBy(Record a[], int n, KeyFn key, int digitBits = 8, int threads = 0) {
+    using KeyOf = RadixKeyOf<Record, KeyFn>;
+    using Unsigned = typename KeyOf::Unsigned;
+    CheckDigitBits(digitBits);
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (threads == 1 || n < (1 << 16)) {   // 数据量太小时线程开销不划算
+        RadixSortBy(a, n, key, digitBits);
+        return;
+    }
+    threads = std::min(threads, n);
+
+    const int keyBits = static_cast<int>(sizeof(Unsigned) * 8);
+    const int passes = (keyBits + digitBits - 1) / digitBits;
+    const std::size_t radix = std::size_t(1) << digitBits;
+    const Unsigned mask = static_cast<Unsigned>(radix - 1);
+    // 各线程直方图长度取 16 项（128 字节）的整数倍，起点彼此相距 128 字节的整数倍；
+    // vector 本身不保证 128 字节对齐，相邻两个直方图至多在交界处共享一条缓存行
+    const std::size_t stride = (radix + 15) / 16 * 16;
+
+    std::vector<std::size_t> count(static_cast<std::size_t>(threads) * stride);
+    std::vector<Record> buffer(n);
+    Record* src = a;
+    Record* dst = buffer.data();
+
+    auto runThreads = [threads](const std::function<void(int)>& fn) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (int t = 1; t < threads; ++t) workers.emplace_back(fn, t);
+        fn(0);
+        for (std::thread& w : workers) w.join();
+    };
+    auto chunkBegin = [n, threads](int t) {
+        return static_cast<int>(static_cast<long long>(n) * t / threads);
+    };
+
+    for (int p = 0; p < passes; ++p) {
+        const int shift = p * digitBits;
+        // 1) 各线程统计本区间直方图
+        runThreads([&](int t) {
+            std::size_t* c = &count[t * stride];
+            std::fill(c, c + radix, 0);
+            for (int i = chunkBegin(t), e = chunkBegin(t + 1); i < e; ++i) {
+                Unsigned k = KeyOf::Traits::toUnsigned(key(src[i]));
+                ++c[(k >> shift) & mask];
+            }
+        });
+
+        // 2) 桶号优先、线程号其次的前缀和（本趟只有一个桶就跳过）
+        std::size_t sum = 0;
+        bool single = false;
+        for (std::size_t d = 0; d < radix; ++d) {
+            std::size_t bucketTotal = 0;
+            for (int t = 0; t < threads; ++t) {
+                std::size_t v = count[t * stride + d];
+                count[t * stride + d] = sum + bucketTotal;
+                bucketTotal += v;
+            }
+            if (bucketTotal == static_cast<std::size_t>(n)) single = true;
+            sum += bucketTotal;
+        }
+        if (single) continue;
+
+        // 3) 各线程把自己区间搬到输出数组
+        runThreads([&](int t) {
+            std::size_t* c = &count[t * stride];
+            for (int i = chunkBegin(t), e = chunkBegin(t + 1); i < e; ++i) {
+                Unsigned k = KeyOf::Traits::toUnsigned(key(src[i]));
+                dst[c[(k >> shift) & mask]++] = std::move(src[i]);
+            }
+        });
+        std::swap(src, dst);
+    }
+    if (src != a) std::move(src, src + n, a);
+}
+
+template <class Key>
+void ParallelRadixSort(Key a[], int n, int digitBits = 8, int threads = 0) {
+    ParallelRadixSortBy(a, n, [](const Key& k) { return k; }, digitBits, threads);
+}
+
+// 在随机 int 上比较链式实现、计数实现（8/11/16 位）、多线程实现与 std::sort
+void BenchmarkRadixSort(int n) {
+    std::mt19937 rng(2024);
+    std::vector<int> base(n);
+    for (int& x : base) x = static_cast<int>(rng());
+    std::vector<int> expect = base;
+    std::sort(expect.begin(), expect.end());
+
+    auto timeIt = [&](const char* name, const std::function<void(std::vector<int>&)>& sortFn) {
+        std::vector<int> x = base;
+        auto t0 = std::chrono::steady_clock::now();
+        sortFn(x);
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms"
+                  << (x == expect ? "" : "  [MISMATCH]") << "\n";
+    };
+    timeIt("std::sort", [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+    timeIt("RadixSortCounting 8-bit", [](std::vector<int>& v) { RadixSortCounting(v.data(), (int)v.size(), 8); });
+    timeIt("RadixSortCounting 11-bit", [](std::vector<int>& v) { RadixSortCounting(v.data(), (int)v.size(), 11); });
+    timeIt("RadixSortCounting 16-bit", [](std::vector<int>& v) { RadixSortCounting(v.data(), (int)v.size(), 16); });
+    timeIt("ParallelRadixSort 8-bit", [](std::vector<int>& v) { ParallelRadixSort(v.data(), (int)v.size(), 8, 4); });
+
+    // 链式实现只接受非负整数：对同一批数据取非负部分单独计时
+    std::vector<int> nonNeg = base;
+    for (int& x : nonNeg) x &= 0x7fffffff;
+    auto t0 = std::chrono::steady_clock::now();
+    RadixSortLSD(nonNeg.data(), n, 10);
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "  RadixSortLSD (linked list, radix 10, non-negative keys): "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+}
+
 void PrintArray(const int a[], int n, const std::string& title) {
     std::cout << title << "\n";
     for (int i = 0; i < n; ++i) std::cout << a[i] << (i + 1 == n ? '\n' : ' ');
 }
 
+// 定义 SORT_BENCHMARK_NO_MAIN 时不编译演示 main，供 排序性能测试.cpp 直接包含本文件
+#ifndef SORT_BENCHMARK_NO_MAIN
 int main() {
     int n;
     std::cout << "Input n and n non-negative integers:\n";
@@ -150,5 +409,28 @@ int main() {
     PrintArray(a.data(), n, "[Original]");
     PrintArray(b.data(), n, "[RadixSortLSD] (课件 9.6 第62-71页)");
 
+    // 计数版不要求非负：这里额外放入几个负数演示关键字变换
+    std::vector<int> c = a;
+    c.push_back(-5);
+    c.push_back(-100);
+    RadixSortCounting(c.data(), static_cast<int>(c.size()), 8);
+    PrintArray(c.data(), static_cast<int>(c.size()), "[RadixSortCounting] (加入 -5, -100 后，8 位一趟)");
+
+    std::vector<double> f = {3.5, -0.25, 1e10, -1e-3, 0.0, -7.0, 2.0};
+    RadixSortCounting(f.data(), static_cast<int>(f.size()), 16);
+    std::cout << "[RadixSortCounting<double>] (16 位一趟)\n";
+    for (std::size_t i = 0; i < f.size(); ++i) std::cout << f[i] << (i + 1 == f.size() ? '\n' : ' ');
+
+    // 按关键字提取函数排序记录：按分数升序，同分保持输入次序（稳定）
+    struct Student { std::string name; int score; };
+    std::vector<Student> stu = {{"Li", 90}, {"Wang", 85}, {"Zhang", 90}, {"Zhao", -1}, {"Liu", 85}};
+    RadixSortBy(stu.data(), static_cast<int>(stu.size()), [](const Student& s) { return s.score; }, 11);
+    std::cout << "[RadixSortBy] (按 score，稳定)\n";
+    for (const Student& s : stu) std::cout << "  " << s.name << " " << s.score << "\n";
+
+    std::cout << "[Benchmark] n = " << (1 << 22) << "\n";
+    BenchmarkRadixSort(1 << 22);
+
     return 0;
 }
+#endif
@@ -5,6 +5,10 @@
 //   1) MergeSortHelp（递归拆分 + 归并）（课件第58页）
 //   2) Merge（两段有序子序列的2-路归并）（课件第59-60页）
 //   3) MergeSort（对外封装：申请辅助数组 temElem，再调用 MergeSortHelp）
+//   4) MergeSortBottomUp（自底向上、ping-pong 缓冲的非递归归并排序）
+//   5) NaturalMergeSort（识别天然游程 + 倍增查找归并的 TimSort 风格排序）
+//   6) ParallelMergeSort（左右两半与归并本身都并行的多线程归并排序）
+//   7) ExternalSortLines（外部排序：内存排序生成归并段 + 败者树 LoserTree 的 k 路归并）
 //
 // 课件核心思想（9.5，课件第53-55页）：
 //   - 将两个（或多个）有序子序列“归并”为一个有序序列
@@ -16,7 +20,7 @@
 //   - 辅助空间 O(n)（课件第79页）
 //
 // 编译运行（示例）：
-//   g++ -std=c++17 -O2 -Wall 归并排序.cpp -o merge_sort
+//   g++ -std=c++17 -O2 -Wall -pthread 归并排序.cpp -o merge_sort
 //   ./merge_sort
 // 输入格式：
 //   n
@@ -27,6 +31,14 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 template <class ElemType>
 void PrintArray(const ElemType elem[], int n, const std::string& title) {
@@ -85,6 +97,521 @@ void MergeSort(ElemType elem[], int n) {
     MergeSortHelp(elem, temElem.data(), 0, n - 1);
 }
 
+// ============================================================
+// 9.5（续一）自底向上的归并排序 MergeSortBottomUp
+// ------------------------------------------------------------
+// 课件的 MergeSortHelp 自顶向下递归到单个元素再逐层归并。
+// 换个方向看：第 1 趟把相邻的长度为 1 的段两两归并成长度 2，第 2 趟归并成长度 4……
+// 共 ceil(log2 n) 趟，不需要递归（课件第54页“2-路归并”的示意图本身就是自底向上的）。
+// 另外两块数组轮流作为“输入/输出”（ping-pong），省去课件 Merge 每次把 temElem 复制回 elem 的开销；
+// 趟数为奇数时最后整体搬回一次即可。
+// ============================================================
+
+// 把 src[low..mid] 与 src[mid+1..high] 归并到 dst[low..high]（相等取左段，保持稳定）
+template <class ElemType>
+void MergeInto(ElemType src[], ElemType dst[], int low, int mid, int high) {
+    int i = low, j = mid + 1, k = low;
+    while (i <= mid && j <= high) {
+        if (src[j] < src[i]) dst[k++] = std::move(src[j++]);
+        else                 dst[k++] = std::move(src[i++]);
+    }
+    while (i <= mid)  dst[k++] = std::move(src[i++]);
+    while (j <= high) dst[k++] = std::move(src[j++]);
+}
+
+template <class ElemType>
+void MergeSortBottomUp(ElemType elem[], int n) {
+    if (n <= 1) return;
+    std::vector<ElemType> buffer(n);
+    ElemType* src = elem;
+    ElemType* dst = buffer.data();
+    for (int width = 1; width < n; width *= 2) {
+        for (int low = 0; low < n; low += 2 * width) {
+            int mid = std::min(low + width - 1, n - 1);
+            int high = std::min(low + 2 * width - 1, n - 1);
+            MergeInto(src, dst, low, mid, high);   // 末尾不足一段时 mid == high，相当于直接搬运
+        }
+        std::swap(src, dst);
+    }
+    if (src != elem) std::move(src, src + n, elem);
+}
+
+// ============================================================
+// 9.5（续二）自然归并排序 NaturalMergeSort（TimSort 风格）
+// ------------------------------------------------------------
+// 实际数据往往“部分有序”（日志按时间追加、表格按某列预排过……），
+// 课件的归并排序却总是从长度 1 开始归并，白白浪费已有的有序性。自然归并排序的做法：
+//   1) 从左到右扫描，识别天然有序的“游程”(run)：非降序直接用，严格降序的原地翻转
+//      （只翻转严格降序段，才不会破坏相等元素的次序）；
+//   2) 游程太短（< minRun）时用折半插入排序把它补足到 minRun，minRun 取 32~64 之间，
+//      使得游程数接近 2 的幂，后面的归并比较平衡；
+//   3) 游程按出现次序压栈，并维持栈顶三段长度 X, Y, Z 满足 X > Y + Z、Y > Z，
+//      否则合并相邻两段——这样每次合并的两段长度相近，总代价 O(nlogn)；
+//   4) 合并时先用二分跳过“已经在位”的头尾（左段中 <= 右段首元素的前缀、右段中 >= 左段末元素的后缀），
+//      再逐个归并；若某一段连续胜出 minGallop 次，说明两段关键字“成片”分布，
+//      改用倍增查找(galloping)一次搬运一整块，胜出减少时再退回逐个比较。
+// 对已经有序的输入只需 n-1 次比较，对随机输入与普通归并排序相当。
+// 辅助数组在整个排序过程中只申请一次并反复复用。
+// ============================================================
+const int kNaturalMergeMinGallop = 7;
+
+template <class ElemType>
+class NaturalMergeSorter {
+public:
+    // buffer 至少能容纳 n 个元素；为 nullptr 时内部自行申请
+    NaturalMergeSorter(ElemType elem[], int n, ElemType* buffer = nullptr)
+        : elem_(elem), n_(n), buffer_(buffer) {
+        if (!buffer_ && n_ > 1) {
+            own_.resize(n_);
+            buffer_ = own_.data();
+        }
+    }
+
+    void sort() {
+        if (n_ <= 1) return;
+        int minRun = MinRunLength(n_);
+        int low = 0;
+        while (low < n_) {
+            int runLen = CountRunAndMakeAscending(low);
+            if (runLen < minRun) {                  // 短游程用折半插入排序补足到 minRun
+                int forced = std::min(minRun, n_ - low);
+                BinaryInsertionSort(low, low + forced, low + runLen);
+                runLen = forced;
+            }
+            runBase_.push_back(low);
+            runLen_.push_back(runLen);
+            MergeCollapse();
+            low += runLen;
+        }
+        MergeForceCollapse();
+    }
+
+private:
+    static int MinRunLength(int n) {
+        int r = 0;
+        while (n >= 64) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // 从 low 开始的游程长度；严格降序的游程原地翻转成升序
+    int CountRunAndMakeAscending(int low) {
+        int high = low + 1;
+        if (high == n_) return 1;
+        if (elem_[high] < elem_[low]) {
+            while (high + 1 < n_ && elem_[high + 1] < elem_[high]) ++high;
+            std::reverse(elem_ + low, elem_ + high + 1);
+        } else {
+            while (high + 1 < n_ && !(elem_[high + 1] < elem_[high])) ++high;
+        }
+        return high - low + 1;
+    }
+
+    // [low, start) 已有序，把 [start, high) 逐个折半插入；用 upper_bound 保证稳定
+    void BinaryInsertionSort(int low, int high, int start) {
+        for (int i = start; i < high; ++i) {
+            ElemType e = std::move(elem_[i]);
+            ElemType* pos = std::upper_bound(elem_ + low, elem_ + i, e);
+            std::move_backward(pos, elem_ + i, elem_ + i + 1);
+            *pos = std::move(e);
+        }
+    }
+
+    // 倍增查找：在有序区间 [first, first+len) 中找第一个使 pred 为 false 的位置（pred 单调由真到假）
+    template <class Pred>
+    static int Gallop(const ElemType* first, int len, Pred pred) {
+        int hi = 1;
+        while (hi < len && pred(first[hi - 1])) hi *= 2;
+        int lo = hi / 2;
+        hi = std::min(hi, len);
+        return static_cast<int>(std::partition_point(first + lo, first + hi, pred) - first);
+    }
+
+    // 维持栈不变式：len[n-2] > len[n-1] + len[n] 且 len[n-1] > len[n]
+    // （同时检查更下一层，避免不变式在深处被破坏）
+    void MergeCollapse() {
+        while (runLen_.size() > 1) {
+            int k = static_cast<int>(runLen_.size()) - 2;
+            if ((k > 0 && runLen_[k - 1] <= runLen_[k] + runLen_[k + 1]) ||
+                (k > 1 && runLen_[k - 2] <= runLen_[k - 1] + runLen_[k])) {
+                if (runLen_[k - 1] < runLen_[k + 1]) --k;
+            } else if (runLen_[k] > runLen_[k + 1]) {
+                break;
+            }
+            MergeAt(k);
+        }
+    }
+
+    void MergeForceCollapse() {
+        while (runLen_.size() > 1) {
+            int k = static_cast<int>(runLen_.size()) - 2;
+            if (k > 0 && runLen_[k - 1] < runLen_[k + 1]) --k;
+            MergeAt(k);
+        }
+    }
+
+    // 合并栈中第 k 与 k+1 个游程（它们在数组中相邻）
+    void MergeAt(int k) {
+        int base = runBase_[k];
+        int mid = base + runLen_[k];
+        int end = mid + runLen_[k + 1];
+        runLen_[k] += runLen_[k + 1];
+        runBase_.erase(runBase_.begin() + k + 1);
+        runLen_.erase(runLen_.begin() + k + 1);
+        MergeRuns(base, mid, end);
+    }
+
+    // 归并 [low, mid) 与 [mid, high)
+    void MergeRuns(int low, int mid, int high) {
+        // 左段中 <= elem[mid] 的前缀已经在最终位置
+        low = static_cast<int>(std::upper_bound(elem_ + low, elem_ + mid, elem_[mid]) - elem_);
+        if (low == mid) return;
+        // 右段中 >= elem[mid-1] 的后缀也已经在最终位置
+        high = static_cast<int>(std::lower_bound(elem_ + mid, elem_ + high, elem_[mid - 1]) - elem_);
+
+        // 左段搬到缓冲区，右段留在原地，从 low 开始写回
+        const int leftLen = mid - low;
+        std::move(elem_ + low, elem_ + mid, buffer_);
+        const ElemType* left = buffer_;
+        int i = 0, j = mid, k = low;
+        int minGallop = minGallop_;
+
+        while (i < leftLen && j < high) {
+            // 逐个归并，统计一方连续胜出次数
+            int winsLeft = 0, winsRight = 0;
+            while (i < leftLen && j < high) {
+                if (elem_[j] < left[i]) {
+                    elem_[k++] = std::move(elem_[j++]);
+                    ++winsRight;
+                    winsLeft = 0;
+                } else {
+                    elem_[k++] = std::move(buffer_[i++]);
+                    ++winsLeft;
+                    winsRight = 0;
+                }
+                if (winsLeft >= minGallop || winsRight >= minGallop) break;
+            }
+            if (i >= leftLen || j >= high) break;
+
+            // 倍增查找模式：整块搬运
+            while (true) {
+                const ElemType& r = elem_[j];
+                int takeLeft = Gallop(left + i, leftLen - i, [&r](const ElemType& x) { return !(r < x); });
+                k = static_cast<int>(std::move(buffer_ + i, buffer_ + i + takeLeft, elem_ + k) - elem_);
+                i += takeLeft;
+                if (i >= leftLen) break;
+
+                const ElemType& l = left[i];
+                int takeRight = Gallop(elem_ + j, high - j, [&l](const ElemType& x) { return x < l; });
+                k = static_cast<int>(std::move(elem_ + j, elem_ + j + takeRight, elem_ + k) - elem_);
+                j += takeRight;
+                if (j >= high) break;
+
+                if (minGallop > 1) --minGallop;     // 倍增查找有效，下次更早进入
+                if (takeLeft < kNaturalMergeMinGallop && takeRight < kNaturalMergeMinGallop) break;
+            }
+            ++minGallop;                            // 退出倍增查找模式，提高再次进入的门槛
+        }
+        minGallop_ = std::max(1, minGallop);
+        // 右段剩余元素本来就在原地；左段剩余元素搬回
+        std::move(buffer_ + i, buffer_ + leftLen, elem_ + k);
+    }
+
+    ElemType* elem_;
+    int n_;
+    ElemType* buffer_;
+    std::vector<ElemType> own_;
+    std::vector<int> runBase_;
+    std::vector<int> runLen_;
+    int minGallop_ = kNaturalMergeMinGallop;
+};
+
+template <class ElemType>
+void NaturalMergeSort(ElemType elem[], int n) {
+    NaturalMergeSorter<ElemType>(elem, n).sort();
+}
+
+// ============================================================
+// 9.5（续三）并行归并排序 ParallelMergeSort
+// ------------------------------------------------------------
+// 左右两半互不相交，可以由两个线程同时排序；难点在最后的“归并”本身也要并行：
+//   取较长一段 A 的中间元素 A[m]，在另一段 B 中二分出它的位置 B[q]，
+//   则 A[m] 在输出中的位置就是 m + q，且 A[0..m)、B[0..q) 全部落在它左侧，
+//   A[m+1..)、B[q..) 全部落在右侧——左右两个子问题又可以交给两个线程。
+//   （A 在 B 之前：在 B 中用 lower_bound，在 A 中用 upper_bound，相等元素前者优先，保持稳定。）
+// 两块数组 ping-pong：每层递归决定结果落在哪块，省去复制回原数组。
+// 递归 depth 层后不再开线程，叶子区间用 NaturalMergeSort 串行排序。
+// ============================================================
+const int kParallelMergeGrain = 1 << 13;
+
+template <class ElemType>
+void ParallelMergeRec(ElemType* a, int na, ElemType* b, int nb, ElemType* out, int depth) {
+    if (depth <= 0 || na + nb <= kParallelMergeGrain) {
+        int i = 0, j = 0, k = 0;
+        while (i < na && j < nb) {
+            if (b[j] < a[i]) out[k++] = std::move(b[j++]);
+            else             out[k++] = std::move(a[i++]);
+        }
+        std::move(a + i, a + na, out + k);
+        std::move(b + j, b + nb, out + k + (na - i));
+        return;
+    }
+    int ma, mb;
+    ElemType* pivot;
+    if (na >= nb) {
+        ma = na / 2;
+        mb = static_cast<int>(std::lower_bound(b, b + nb, a[ma]) - b);
+        pivot = a + ma;
+    } else {
+        mb = nb / 2;
+        ma = static_cast<int>(std::upper_bound(a, a + na, b[mb]) - a);
+        pivot = b + mb;
+    }
+    out[ma + mb] = std::move(*pivot);
+    // 支点来自 A 时右子问题为 A[ma+1..)、B[mb..)；来自 B 时为 A[ma..)、B[mb+1..)
+    int skipA = na >= nb ? 1 : 0;
+    int skipB = 1 - skipA;
+    std::thread left([=]() { ParallelMergeRec(a, ma, b, mb, out, depth - 1); });
+    ParallelMergeRec(a + ma + skipA, na - ma - skipA, b + mb + skipB, nb - mb - skipB,
+                     out + ma + mb + 1, depth - 1);
+    left.join();
+}
+
+// 排序 a[low..high)；intoB 为真时结果写到 b[low..high)，否则留在 a[low..high)
+template <class ElemType>
+void ParallelMergeSortRec(ElemType* a, ElemType* b, int low, int high, int depth, bool intoB) {
+    if (depth <= 0 || high - low <= kParallelMergeGrain) {
+        NaturalMergeSorter<ElemType>(a + low, high - low, b + low).sort();
+        if (intoB) std::move(a + low, a + high, b + low);
+        return;
+    }
+    int mid = low + (high - low) / 2;
+    std::thread left([=]() { ParallelMergeSortRec(a, b, low, mid, depth - 1, !intoB); });
+    ParallelMergeSortRec(a, b, mid, high, depth - 1, !intoB);
+    left.join();
+    ElemType* src = intoB ? a : b;
+    ElemType* dst = intoB ? b : a;
+    ParallelMergeRec(src + low, mid - low, src + mid, high - mid, dst + low, depth);
+}
+
+// threads：最多同时运行的线程数（取不超过它的 2 的幂），0 表示使用 hardware_concurrency()
+template <class ElemType>
+void ParallelMergeSort(ElemType elem[], int n, unsigned threads = 0) {
+    if (n <= 1) return;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((2u << depth) <= threads) ++depth;
+    std::vector<ElemType> buffer(n);
+    ParallelMergeSortRec(elem, buffer.data(), 0, n, depth, false);
+}
+
+// ============================================================
+// 9.5（续四）外部排序：置换出有序归并段 + 败者树 k 路归并
+// ------------------------------------------------------------
+// 待排数据远大于内存时（例如每晚几百 GB 的日志），分两个阶段：
+//   1) 生成初始归并段：每次读入不超过 memoryBytes 的行，内存中排序后写成一个临时“归并段”文件；
+//   2) 多路归并：每次同时打开 k 个归并段，反复取出 k 个段首行中最小者写出。
+//      从 k 个候选中选最小，用“败者树”(loser tree)：内部结点记录比赛的败者、根上方记录总冠军，
+//      冠军输出后只需沿它所在叶子到根重赛一遍，每输出一行只做 ceil(log2 k) 次比较
+//      （堆要在两个孩子间都比一次，败者树每层只需与记录的败者比一次）。
+//   若归并段多于 k 个，则分多趟进行，每趟段数缩小为 1/k；总趟数 ceil(log_k(段数))。
+// 段序号小的归并段来自输入的前部，比较相等时让段序号小者胜出，整个外部排序是稳定的。
+// ============================================================
+
+// 败者树：k 个参赛者编号 0..k-1；beats(a, b) 为真表示 a 应排在 b 之前
+// tree_[1..k-1] 保存各场比赛的败者，tree_[0] 保存冠军；叶子 i 的父结点为 (i + k) / 2
+template <class BeatsFn>
+class LoserTree {
+public:
+    LoserTree(int k, BeatsFn beats) : k_(k), tree_(std::max(1, k), 0), beats_(beats) {
+        if (k_ > 1) tree_[0] = Build(1);
+    }
+
+    int winner() const { return tree_[0]; }
+
+    // 参赛者 leaf 的关键字已改变（通常是冠军换上了它所在段的下一行），从该叶子重赛到根
+    void replay(int leaf) {
+        int winner = leaf;
+        for (int node = (leaf + k_) / 2; node >= 1; node /= 2) {
+            if (beats_(tree_[node], winner)) std::swap(tree_[node], winner);
+        }
+        tree_[0] = winner;
+    }
+
+private:
+    int Build(int node) {
+        if (node >= k_) return node - k_;
+        int l = Build(2 * node);
+        int r = Build(2 * node + 1);
+        if (beats_(l, r)) { tree_[node] = r; return l; }
+        tree_[node] = l;
+        return r;
+    }
+
+    int k_;
+    std::vector<int> tree_;
+    BeatsFn beats_;
+};
+
+template <class BeatsFn>
+LoserTree<BeatsFn> MakeLoserTree(int k, BeatsFn beats) {
+    return LoserTree<BeatsFn>(k, beats);
+}
+
+// 把 inputs 中的若干有序行文件 k 路归并写到 output
+inline void MergeLineFiles(const std::vector<std::string>& inputs, const std::string& output) {
+    const int k = static_cast<int>(inputs.size());
+    std::vector<std::unique_ptr<std::ifstream>> in(k);
+    std::vector<std::string> head(k);
+    std::vector<char> alive(k, 0);
+    for (int i = 0; i < k; ++i) {
+        in[i].reset(new std::ifstream(inputs[i], std::ios::binary));
+        if (!*in[i]) throw std::runtime_error("cannot open run file " + inputs[i]);
+        alive[i] = static_cast<bool>(std::getline(*in[i], head[i]));
+    }
+    std::ofstream out(output, std::ios::binary);
+    if (!out) throw std::runtime_error("cannot create " + output);
+
+    auto tree = MakeLoserTree(k, [&](int a, int b) {
+        if (!alive[a]) return false;
+        if (!alive[b]) return true;
+        if (head[a] < head[b]) return true;
+        if (head[b] < head[a]) return false;
+        return a < b;
+    });
+    while (true) {
+        int w = tree.winner();
+        if (!alive[w]) break;             // 冠军已耗尽说明所有段都耗尽
+        out << head[w] << '\n';
+        alive[w] = static_cast<bool>(std::getline(*in[w], head[w]));
+        tree.replay(w);
+    }
+    if (!out) throw std::runtime_error("write failed: " + output);
+}
+
+// 按行对文本文件做外部排序（行按字节序比较，结果稳定）
+//   memoryBytes - 生成初始归并段时允许占用的内存上限（粗略按字符串容量估算）
+//   fanIn       - 每趟归并的路数 k（>= 2）
+//   tempPrefix  - 临时归并段文件名前缀，可带目录
+// 返回初始归并段个数
+inline int ExternalSortLines(const std::string& inputPath, const std::string& outputPath,
+                             std::size_t memoryBytes = std::size_t(256) << 20, int fanIn = 64,
+                             const std::string& tempPrefix = "extsort_run") {
+    if (fanIn < 2) throw std::invalid_argument("fanIn must be >= 2");
+    std::ifstream in(inputPath, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + inputPath);
+
+    int fileSerial = 0;
+    auto tempName = [&]() { return tempPrefix + "_" + std::to_string(fileSerial++) + ".tmp"; };
+
+    // 1) 生成初始归并段
+    std::vector<std::string> runs;
+    std::vector<std::string> lines;
+    std::vector<std::string> scratch;
+    std::string line;
+    bool more = true;
+    while (more) {
+        lines.clear();
+        std::size_t used = 0;
+        while (used < memoryBytes && (more = static_cast<bool>(std::getline(in, line)))) {
+            used += line.capacity() + sizeof(std::string);
+            lines.push_back(std::move(line));
+            line.clear();
+        }
+        if (lines.empty()) break;
+        scratch.resize(lines.size());
+        NaturalMergeSorter<std::string>(lines.data(), static_cast<int>(lines.size()), scratch.data()).sort();
+        runs.push_back(tempName());
+        std::ofstream out(runs.back(), std::ios::binary);
+        for (const std::string& s : lines) out << s << '\n';
+        if (!out) throw std::runtime_error("write failed: " + runs.back());
+    }
+    const int initialRuns = static_cast<int>(runs.size());
+    if (runs.empty()) {                       // 空输入
+        std::ofstream out(outputPath, std::ios::binary);
+        return 0;
+    }
+
+    // 2) 多趟 k 路归并，最后一趟直接写到 outputPath
+    while (true) {
+        std::vector<std::string> next;
+        bool lastPass = static_cast<int>(runs.size()) <= fanIn;
+        for (std::size_t g = 0; g < runs.size(); g += fanIn) {
+            std::vector<std::string> group(runs.begin() + g,
+                                           runs.begin() + std::min(runs.size(), g + fanIn));
+            std::string target = lastPass ? outputPath : tempName();
+            MergeLineFiles(group, target);
+            for (const std::string& f : group) std::remove(f.c_str());
+            next.push_back(target);
+        }
+        if (lastPass) break;
+        runs.swap(next);
+    }
+    return initialRuns;
+}
+
+// 在随机 / 基本有序两种输入上比较几种归并排序与 std::stable_sort
+void BenchmarkMergeSort(int n) {
+    std::mt19937 rng(2024);
+    for (int kind = 0; kind < 2; ++kind) {
+        std::vector<int> base(n);
+        for (int i = 0; i < n; ++i) base[i] = kind == 0 ? static_cast<int>(rng()) : i;
+        if (kind == 1) {                      // 有序序列中随机打乱 1% 的位置
+            for (int t = 0; t < n / 100; ++t) std::swap(base[rng() % n], base[rng() % n]);
+        }
+        std::vector<int> expect = base;
+        std::stable_sort(expect.begin(), expect.end());
+
+        std::cout << "  " << (kind == 0 ? "random" : "nearly sorted") << ":";
+        auto timeIt = [&](const char* name, void (*sortFn)(int*, int)) {
+            std::vector<int> x = base;
+            auto t0 = std::chrono::steady_clock::now();
+            sortFn(x.data(), n);
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << " " << name << " " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                      << " ms" << (x == expect ? "" : " [MISMATCH]") << ";";
+        };
+        timeIt("MergeSort", [](int* a, int m) { MergeSort(a, m); });
+        timeIt("BottomUp", [](int* a, int m) { MergeSortBottomUp(a, m); });
+        timeIt("Natural", [](int* a, int m) { NaturalMergeSort(a, m); });
+        timeIt("Parallel", [](int* a, int m) { ParallelMergeSort(a, m, 4); });
+        std::cout << "\n";
+    }
+}
+
+// 生成随机文本行，用很小的内存上限做外部排序，并与内存中排序的结果比对
+void DemoExternalSort() {
+    const std::string input = "extsort_demo_input.txt";
+    const std::string output = "extsort_demo_output.txt";
+    std::mt19937 rng(7);
+    std::vector<std::string> lines;
+    {
+        std::ofstream out(input, std::ios::binary);
+        for (int i = 0; i < 20000; ++i) {
+            std::string s = "2024-06-" + std::to_string(10 + rng() % 20) + " req=" + std::to_string(rng() % 100000);
+            out << s << '\n';
+            lines.push_back(s);
+        }
+    }
+    int runs = ExternalSortLines(input, output, 64 << 10, 4, "extsort_demo_run");
+    std::stable_sort(lines.begin(), lines.end());
+    std::ifstream in(output, std::ios::binary);
+    std::string s;
+    std::size_t idx = 0;
+    bool ok = true;
+    while (std::getline(in, s)) ok = ok && idx < lines.size() && s == lines[idx++];
+    ok = ok && idx == lines.size();
+    in.close();
+    std::cout << "[ExternalSortLines] 20000 lines, 64 KiB memory, 4-way merge: " << runs
+              << " initial runs, result " << (ok ? "matches" : "MISMATCH") << "\n";
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+// 定义 SORT_BENCHMARK_NO_MAIN 时不编译演示 main，供 排序性能测试.cpp 直接包含本文件
+#ifndef SORT_BENCHMARK_NO_MAIN
 int main() {
     int n;
     std::cout << "Input n and n integers:\n";
@@ -98,5 +625,23 @@ int main() {
     PrintArray(a.data(), n, "[Original]");
     PrintArray(b.data(), n, "[MergeSort] (课件 9.5 第53-60页)");
 
+    std::vector<int> c = a;
+    MergeSortBottomUp(c.data(), n);
+    PrintArray(c.data(), n, "[MergeSortBottomUp] (自底向上)");
+
+    std::vector<int> d = a;
+    NaturalMergeSort(d.data(), n);
+    PrintArray(d.data(), n, "[NaturalMergeSort] (天然游程 + 倍增查找归并)");
+
+    std::vector<int> e = a;
+    ParallelMergeSort(e.data(), n);
+    PrintArray(e.data(), n, "[ParallelMergeSort]");
+
+    DemoExternalSort();
+
+    std::cout << "[Benchmark] n = " << (1 << 22) << "\n";
+    BenchmarkMergeSort(1 << 22);
+
     return 0;
 }
+#endif
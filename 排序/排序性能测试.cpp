@@ -0,0 +1,352 @@
+// 排序性能测试.cpp
+// ------------------------------------------------------------
+// 依据课件《Ch09 排序 2024》（孙奕髦，四川大学）第78-79页“各种排序方法的比较”编写的实测程序。
+// 课件从时间复杂度、辅助空间、稳定性三方面比较了各种内部排序；这里把同一目录下的实现放在
+// 同一组输入上实际跑一遍，统计：
+//   - ns/elem     ：每个元素平均耗时（纳秒，对 int 数组计时，多次重复取最小值）
+//   - comparisons ：关键字比较次数（用带计数的元素类型 Counted 再跑一遍统计）
+//   - moves       ：元素移动次数（拷贝/移动构造与赋值次数之和，一次 swap 计 3 次）
+//   - allocations ：排序过程中调用 operator new 的次数（替换全局 operator new 统计）
+// 输入分布：random（均匀随机）、sorted（已有序）、reverse（逆序）、
+//           few-unique（只有 16 种不同关键字）、zipf（Zipf 分布，s = 1，大量重复的热点关键字）。
+// 结果按 CSV 输出到标准输出，进度信息输出到标准错误，便于重定向后用表格或脚本对比回归。
+//
+// 课件第78-79页的结论可以在结果中直接看到：
+//   - 直接插入/冒泡/简单选择为 O(n^2)，只适合小规模或基本有序的数据；
+//   - 课件版快速排序在有序、逆序、大量重复时退化为 O(n^2)（这些情形下只测到 kQuadraticLimit）；
+//   - 基数排序不做关键字比较，comparisons 为 0。
+//
+// 本程序直接包含同目录下的五个排序文件（各自放进一个命名空间，避免同名的 PrintArray 等冲突），
+// 并定义 SORT_BENCHMARK_NO_MAIN 屏蔽它们的演示 main。
+//
+// 编译运行（示例）：
+//   g++ -std=c++17 -O2 -Wall -pthread 排序性能测试.cpp -o sort_bench
+//   ./sort_bench                 # 规模 1e3, 1e4, 1e5, 1e6
+//   ./sort_bench 100000000 > sort_bench.csv   # 规模 1e3 .. 1e8（需要数 GB 内存与较长时间）
+// 命令行参数：
+//   argv[1] 最大规模 maxN（默认 1000000），规模从 1000 起每次乘 10 直到 maxN
+//
+// ------------------------------------------------------------
+
+// 先包含各排序文件用到的全部标准头文件：之后在命名空间内再次 #include 时会被头文件保护跳过
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define SORT_BENCHMARK_NO_MAIN
+namespace insert_sort {
+#include "插入排序.cpp"
+}
+namespace exchange_sort {
+#include "交换排序.cpp"
+}
+namespace select_sort {
+#include "选择排序.cpp"
+}
+namespace merge_sort {
+#include "归并排序.cpp"
+}
+namespace radix_sort {
+#include "基数排序.cpp"
+}
+#undef SORT_BENCHMARK_NO_MAIN
+
+// ============================================================
+// 一、计数：比较次数、移动次数、内存分配次数
+// ------------------------------------------------------------
+// 并行排序会在多个线程里比较/移动元素，计数器用 relaxed 原子变量，只保证总数正确。
+// ============================================================
+static std::atomic<long long> g_comparisons{0};
+static std::atomic<long long> g_moves{0};
+static std::atomic<long long> g_allocations{0};
+
+// 替换全局 operator new/delete：GCC 会把内联后的 free 误报为与 new 不配对，这里关闭该告警
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// 带计数的元素：行为与 int 相同，每次比较/拷贝/移动都计数
+struct Counted {
+    int key = 0;
+
+    Counted() = default;
+    explicit Counted(int k) : key(k) {}
+    Counted(const Counted& o) : key(o.key) { g_moves.fetch_add(1, std::memory_order_relaxed); }
+    Counted(Counted&& o) noexcept : key(o.key) { g_moves.fetch_add(1, std::memory_order_relaxed); }
+    Counted& operator=(const Counted& o) {
+        key = o.key;
+        g_moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+    Counted& operator=(Counted&& o) noexcept {
+        key = o.key;
+        g_moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+
+    static bool count(bool r) {
+        g_comparisons.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+    friend bool operator<(const Counted& a, const Counted& b)  { return count(a.key < b.key); }
+    friend bool operator>(const Counted& a, const Counted& b)  { return count(a.key > b.key); }
+    friend bool operator<=(const Counted& a, const Counted& b) { return count(a.key <= b.key); }
+    friend bool operator>=(const Counted& a, const Counted& b) { return count(a.key >= b.key); }
+};
+
+// ============================================================
+// 二、输入分布
+// ============================================================
+enum class Distribution { Random, Sorted, Reverse, FewUnique, Zipf };
+
+const char* DistributionName(Distribution d) {
+    switch (d) {
+        case Distribution::Random:    return "random";
+        case Distribution::Sorted:    return "sorted";
+        case Distribution::Reverse:   return "reverse";
+        case Distribution::FewUnique: return "few-unique";
+        default:                      return "zipf";
+    }
+}
+
+// 生成 n 个非负 int（课件版 RadixSortLSD 只接受非负整数）
+std::vector<int> MakeInput(Distribution d, int n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<int> a(n);
+    switch (d) {
+        case Distribution::Random:
+            for (int& x : a) x = static_cast<int>(rng() & 0x7fffffff);
+            break;
+        case Distribution::Sorted:
+            for (int i = 0; i < n; ++i) a[i] = i;
+            break;
+        case Distribution::Reverse:
+            for (int i = 0; i < n; ++i) a[i] = n - i;
+            break;
+        case Distribution::FewUnique:
+            for (int& x : a) x = static_cast<int>(rng() % 16) * 1000;
+            break;
+        case Distribution::Zipf: {
+            // 第 r 个关键字出现概率正比于 1/r：预先求累积分布，再对均匀随机数二分
+            const int distinct = std::max(1, std::min(n, 1 << 20));
+            std::vector<double> cdf(distinct);
+            double sum = 0;
+            for (int r = 0; r < distinct; ++r) cdf[r] = (sum += 1.0 / (r + 1));
+            std::uniform_real_distribution<double> uni(0.0, sum);
+            for (int& x : a) {
+                int r = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), uni(rng)) - cdf.begin());
+                // 打散关键字，避免热点恰好有序；乘积可达 8.3e9，须在 64 位中取模
+                x = static_cast<int>(static_cast<long long>(std::min(r, distinct - 1)) * 7919 % 1000003);
+            }
+            break;
+        }
+    }
+    return a;
+}
+
+// ============================================================
+// 三、被测算法表
+// ------------------------------------------------------------
+// 每个算法给出 int 版（计时）与 Counted 版（统计比较/移动/分配）；
+// 为空表示该版本不可用（课件版 RadixSortLSD 只接受 int，比较/移动列留空）。
+// limit(d) 给出该分布下的最大测试规模，用于跳过 O(n^2) 的组合。
+// ============================================================
+const int kQuadraticLimit = 20000;
+
+struct SortEntry {
+    const char* name;
+    std::function<void(int*, int)> sortInt;
+    std::function<void(Counted*, int)> sortCounted;
+    std::function<long long(Distribution)> limit;
+};
+
+std::vector<int> ShellHalvingGaps(int n) {
+    std::vector<int> inc;
+    for (int d = n / 2; d >= 1; d /= 2) inc.push_back(d);
+    if (inc.empty()) inc.push_back(1);
+    return inc;
+}
+
+std::vector<SortEntry> MakeSortEntries() {
+    auto unlimited = [](Distribution) { return std::numeric_limits<long long>::max(); };
+    auto quadratic = [](Distribution) { return static_cast<long long>(kQuadraticLimit); };
+    // 课件版 QuickSort 以首元素为支点，除均匀随机外都会退化（大量重复时 Partition 也一边倒）
+    auto coursePivot = [](Distribution d) {
+        return d == Distribution::Random ? std::numeric_limits<long long>::max()
+                                         : static_cast<long long>(kQuadraticLimit);
+    };
+
+    std::vector<SortEntry> e;
+    e.push_back({"StraightInsertSort",
+                 [](int* a, int n) { insert_sort::StraightInsertSort(a, n); },
+                 [](Counted* a, int n) { insert_sort::StraightInsertSort(a, n); }, quadratic});
+    e.push_back({"ShellSort(n/2^k)",
+                 [](int* a, int n) {
+                     std::vector<int> inc = ShellHalvingGaps(n);
+                     insert_sort::ShellSort(a, n, inc.data(), static_cast<int>(inc.size()));
+                 },
+                 [](Counted* a, int n) {
+                     std::vector<int> inc = ShellHalvingGaps(n);
+                     insert_sort::ShellSort(a, n, inc.data(), static_cast<int>(inc.size()));
+                 },
+                 unlimited});
+    e.push_back({"ShellSortInPlace(auto)",
+                 [](int* a, int n) { insert_sort::ShellSortInPlace(a, n); },
+                 [](Counted* a, int n) { insert_sort::ShellSortInPlace(a, n); }, unlimited});
+    e.push_back({"BubbleSort",
+                 [](int* a, int n) { exchange_sort::BubbleSort(a, n); },
+                 [](Counted* a, int n) { exchange_sort::BubbleSort(a, n); }, quadratic});
+    e.push_back({"QuickSort",
+                 [](int* a, int n) { exchange_sort::QuickSort(a, n); },
+                 [](Counted* a, int n) { exchange_sort::QuickSort(a, n); }, coursePivot});
+    e.push_back({"IntroQuickSort",
+                 [](int* a, int n) { exchange_sort::IntroQuickSort(a, n); },
+                 [](Counted* a, int n) { exchange_sort::IntroQuickSort(a, n); }, unlimited});
+    e.push_back({"ParallelQuickSort",
+                 [](int* a, int n) { exchange_sort::ParallelQuickSort(a, n); },
+                 [](Counted* a, int n) { exchange_sort::ParallelQuickSort(a, n); }, unlimited});
+    e.push_back({"SimpleSelectionSort",
+                 [](int* a, int n) { select_sort::SimpleSelectionSort(a, n); },
+                 [](Counted* a, int n) { select_sort::SimpleSelectionSort(a, n); }, quadratic});
+    e.push_back({"HeapSort",
+                 [](int* a, int n) { select_sort::HeapSort(a, n); },
+                 [](Counted* a, int n) { select_sort::HeapSort(a, n); }, unlimited});
+    e.push_back({"MergeSort",
+                 [](int* a, int n) { merge_sort::MergeSort(a, n); },
+                 [](Counted* a, int n) { merge_sort::MergeSort(a, n); }, unlimited});
+    e.push_back({"MergeSortBottomUp",
+                 [](int* a, int n) { merge_sort::MergeSortBottomUp(a, n); },
+                 [](Counted* a, int n) { merge_sort::MergeSortBottomUp(a, n); }, unlimited});
+    e.push_back({"NaturalMergeSort",
+                 [](int* a, int n) { merge_sort::NaturalMergeSort(a, n); },
+                 [](Counted* a, int n) { merge_sort::NaturalMergeSort(a, n); }, unlimited});
+    e.push_back({"ParallelMergeSort",
+                 [](int* a, int n) { merge_sort::ParallelMergeSort(a, n); },
+                 [](Counted* a, int n) { merge_sort::ParallelMergeSort(a, n); }, unlimited});
+    e.push_back({"RadixSortLSD",
+                 [](int* a, int n) { radix_sort::RadixSortLSD(a, n, 10); },
+                 nullptr, unlimited});
+    e.push_back({"RadixSortCounting",
+                 [](int* a, int n) { radix_sort::RadixSortCounting(a, n, 8); },
+                 [](Counted* a, int n) { radix_sort::RadixSortBy(a, n, [](const Counted& c) { return c.key; }, 8); },
+                 unlimited});
+    e.push_back({"ParallelRadixSort",
+                 [](int* a, int n) { radix_sort::ParallelRadixSort(a, n, 8); },
+                 [](Counted* a, int n) { radix_sort::ParallelRadixSortBy(a, n, [](const Counted& c) { return c.key; }, 8); },
+                 unlimited});
+    e.push_back({"std::sort",
+                 [](int* a, int n) { std::sort(a, a + n); },
+                 [](Counted* a, int n) { std::sort(a, a + n); }, unlimited});
+    return e;
+}
+
+// ============================================================
+// 四、测量与输出
+// ============================================================
+struct Measurement {
+    double nsPerElem = 0;
+    bool verified = false;
+    bool counted = false;
+    long long comparisons = 0, moves = 0, allocations = 0;
+};
+
+Measurement Measure(const SortEntry& entry, const std::vector<int>& input, const std::vector<int>& expect) {
+    const int n = static_cast<int>(input.size());
+    Measurement m;
+
+    // 计时：小规模多跑几遍取最小值，减小计时误差
+    const int reps = std::max(1, std::min(20, 1000000 / std::max(1, n)));
+    double best = 0;
+    std::vector<int> work;
+    for (int r = 0; r < reps; ++r) {
+        work = input;
+        auto t0 = std::chrono::steady_clock::now();
+        entry.sortInt(work.data(), n);
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (r == 0 || ns < best) best = ns;
+    }
+    m.nsPerElem = best / n;
+    m.verified = work == expect;
+
+    // 计数：用 Counted 再跑一遍
+    if (entry.sortCounted) {
+        std::vector<Counted> c(input.begin(), input.end());
+        g_comparisons = 0;
+        g_moves = 0;
+        long long alloc0 = g_allocations.load();
+        entry.sortCounted(c.data(), n);
+        m.allocations = g_allocations.load() - alloc0;
+        m.comparisons = g_comparisons.load();
+        m.moves = g_moves.load();
+        m.counted = true;
+        for (int i = 0; i < n && m.verified; ++i) m.verified = c[i].key == expect[i];
+    } else {
+        // 只能统计分配次数
+        work = input;
+        long long alloc0 = g_allocations.load();
+        entry.sortInt(work.data(), n);
+        m.allocations = g_allocations.load() - alloc0;
+    }
+    return m;
+}
+
+int main(int argc, char* argv[]) {
+    long long maxN = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    if (maxN < 1000) maxN = 1000;
+    if (maxN > 100000000) maxN = 100000000;
+
+    const Distribution dists[] = {Distribution::Random, Distribution::Sorted, Distribution::Reverse,
+                                  Distribution::FewUnique, Distribution::Zipf};
+    std::vector<SortEntry> entries = MakeSortEntries();
+
+    std::cout << "algorithm,distribution,n,ns_per_elem,comparisons,moves,allocations,verified\n";
+    for (long long n = 1000; n <= maxN; n *= 10) {
+        for (Distribution d : dists) {
+            std::vector<int> input = MakeInput(d, static_cast<int>(n), 2024);
+            std::vector<int> expect = input;
+            std::sort(expect.begin(), expect.end());
+            for (const SortEntry& entry : entries) {
+                if (n > entry.limit(d)) continue;
+                std::cerr << "[" << entry.name << " / " << DistributionName(d) << " / n=" << n << "]\n";
+                Measurement m = Measure(entry, input, expect);
+                std::cout << entry.name << ',' << DistributionName(d) << ',' << n << ','
+                          << std::fixed << std::setprecision(3) << m.nsPerElem << ',';
+                if (m.counted) std::cout << m.comparisons << ',' << m.moves;
+                else           std::cout << ',';
+                std::cout << ',' << m.allocations << ',' << (m.verified ? "yes" : "NO") << '\n';
+            }
+        }
+    }
+    return 0;
+}
@@ -4,6 +4,8 @@
 // 本文件实现：
 //   1) 直接插入排序 StraightInsertSort（9.2.1，课件第14-21页）
 //   2) 希尔排序 ShellInsert + ShellSort（9.2.2，课件第23-27页）
+//   3) 内置 Ciura / Tokuda / Sedgewick 增量序列 MakeShellGaps（按 n 自动选择），
+//      以及面向 trivially-copyable 类型的原地快速版 ShellSortInPlace
 //
 // 额外补充（便于你把“代码”和“算法思想”对应起来）：
 //   - 插入类排序的核心：把无序区的一个元素“插入”到有序区中，使有序区逐步扩大。
@@ -27,6 +29,12 @@
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
 
 // 打印数组（仅用于演示）
 template <class ElemType>
@@ -90,7 +98,159 @@ void ShellSort(ElemType elem[], int n, const int inc[], int t) {
     }
 }
 
+// ============================================================
+// 9.2.2（续）内置增量序列与原地快速版希尔排序
+// ------------------------------------------------------------
+// 希尔排序的效率几乎完全取决于增量序列（课件第27页只要求“从大到小、最后为 1”）。
+// 示例 main 里的 n/2, n/4, ..., 1 是 Shell 最初提出的序列，相邻增量成倍数关系，
+// 奇偶位置的元素直到最后一趟才相互比较，最坏 O(n^2)。常用的实测较好的序列：
+//   - Ciura (2001)：1, 4, 10, 23, 57, 132, 301, 701, 1750，为实验所得，更大的增量按 ×2.25 延伸；
+//   - Tokuda (1992)：h_k = ceil((9·(9/4)^k − 4) / 5)，即 1, 4, 9, 20, 46, 103, 233, 525, ...；
+//   - Sedgewick (1986)：9·4^k − 9·2^k + 1 与 4^k − 3·2^k + 1 交替，即 1, 5, 19, 41, 109, 209, ...，
+//     最坏 O(n^(4/3))。
+// MakeShellGaps 把小于 n 的增量按“从大到小”写入调用者提供的数组，
+// 可以直接交给课件接口 ShellSort(elem, n, inc, t)；不申请堆内存。
+// ============================================================
+enum class ShellGapSequence { Auto, Ciura, Tokuda, Sedgewick };
+
+// 任何 int 规模下三种序列都不超过 64 项
+const int kMaxShellGaps = 64;
+
+// 生成小于 n 的增量（至少含 1），按从大到小写入 inc[]，返回个数 t
+inline int MakeShellGaps(int n, ShellGapSequence seq, int inc[]) {
+    if (seq == ShellGapSequence::Auto) {
+        // 规模不大时 Ciura 的实验序列最好；规模再大时 ×2.25 外推缺少实验依据，换用 Tokuda
+        seq = n <= 4000 ? ShellGapSequence::Ciura : ShellGapSequence::Tokuda;
+    }
+    long long gaps[kMaxShellGaps];
+    int t = 0;
+    switch (seq) {
+        case ShellGapSequence::Ciura: {
+            static const int ciura[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+            long long h = 0;
+            for (int g : ciura) gaps[t++] = h = g;
+            while (h < n) gaps[t++] = h = static_cast<long long>(h * 2.25);
+            break;
+        }
+        case ShellGapSequence::Tokuda: {
+            double p = 1.0;                       // (9/4)^k
+            for (long long h = 1; h < n || t == 0; p *= 2.25) {
+                h = static_cast<long long>(std::ceil((9.0 * p - 4.0) / 5.0));
+                gaps[t++] = h;
+            }
+            break;
+        }
+        default: {                                // Sedgewick
+            for (int k = 0; ; ++k) {
+                long long a = 9 * (1LL << (2 * k)) - 9 * (1LL << k) + 1;
+                long long b = (1LL << (2 * (k + 2))) - 3 * (1LL << (k + 2)) + 1;
+                gaps[t++] = a;
+                if (a >= n) break;
+                gaps[t++] = b;
+                if (b >= n) break;
+            }
+            std::sort(gaps, gaps + t);
+            break;
+        }
+    }
+    // 只保留 < n 的增量，倒序输出；n <= 1 时仍输出一个 1
+    int m = 0;
+    for (int k = t - 1; k >= 0; --k) {
+        if (gaps[k] < n) inc[m++] = static_cast<int>(gaps[k]);
+    }
+    if (m == 0) inc[m++] = 1;
+    return m;
+}
+
+// 按内置增量序列做希尔排序（课件接口的便捷版本）
+template <class ElemType>
+void ShellSort(ElemType elem[], int n, ShellGapSequence seq = ShellGapSequence::Auto) {
+    int inc[kMaxShellGaps];
+    int t = MakeShellGaps(n, seq, inc);
+    ShellSort(elem, n, inc, t);
+}
+
+// ------------------------------------------------------------
+// 快速路径：ShellInsertUnguarded / ShellSortInPlace
+// ------------------------------------------------------------
+// 课件的 ShellInsert 内层循环每一步都要判断 j >= 0 与 e < elem[j] 两个条件。
+// 注意到第 i 个元素所在子序列（i mod incr 那条链）的已排序部分中，链首 elem[i mod incr] 最小：
+//   - 若 e < 链首，则 e 必须放到链首，前面的元素只需整体后移，无需任何比较；
+//   - 否则向前查找必然在链首之前停下，内层循环可以去掉 j >= 0 的边界判断（unguarded），
+//     每一步只剩一次关键字比较。
+// i 从 incr 逐个递增时，相邻的 i 属于不同的链，incr 条链是交错着一起推进的：
+// 每条链的已排序前缀都留在最近访问过的缓存行里，比“一条链排完再排下一条”的访存局部性好得多。
+// 链首下标 head = i mod incr 随 i 递增时循环递增，不需要做除法。
+// （也试过让 i 与 i+1 两条链的内层循环在同一个循环里交错推进，以求指令级并行；
+//  但随机数据下内层循环平均只走一两步，合并后的循环条件更难预测，实测反而更慢，故未采用。）
+// 这条路径只对 trivially-copyable 的类型启用（搬运就是按位拷贝，没有构造/析构副作用），
+// 全程原地进行，除了 MakeShellGaps 的栈上数组外不使用额外内存。
+// ============================================================
+template <class ElemType>
+void ShellInsertUnguarded(ElemType elem[], int n, int incr) {
+    static_assert(std::is_trivially_copyable<ElemType>::value,
+                  "ShellInsertUnguarded requires a trivially copyable element type");
+    int head = 0;                                   // head == i % incr
+    for (int i = incr; i < n; ++i) {
+        ElemType e = elem[i];
+        int j = i;
+        if (e < elem[head]) {                       // 比链首还小：整体后移后放在链首
+            for (; j > head; j -= incr) elem[j] = elem[j - incr];
+            elem[head] = e;
+        } else if (e < elem[j - incr]) {            // 链首 <= e，必在链首之前停下
+            do {
+                elem[j] = elem[j - incr];
+                j -= incr;
+            } while (e < elem[j - incr]);
+            elem[j] = e;
+        }
+        if (++head == incr) head = 0;
+    }
+}
+
+// 原地希尔排序：trivially-copyable 类型走 ShellInsertUnguarded，其余类型退回课件的 ShellInsert
+template <class ElemType>
+void ShellSortInPlace(ElemType elem[], int n, ShellGapSequence seq = ShellGapSequence::Auto) {
+    if (n <= 1) return;
+    int inc[kMaxShellGaps];
+    int t = MakeShellGaps(n, seq, inc);
+    for (int k = 0; k < t; ++k) {
+        if constexpr (std::is_trivially_copyable<ElemType>::value) ShellInsertUnguarded(elem, n, inc[k]);
+        else ShellInsert(elem, n, inc[k]);
+    }
+}
+
+// 比较不同增量序列与快速路径在随机 int 上的耗时
+void BenchmarkShellSort(int n) {
+    std::mt19937 rng(2024);
+    std::vector<int> base(n);
+    for (int& x : base) x = static_cast<int>(rng());
+    std::vector<int> expect = base;
+    std::sort(expect.begin(), expect.end());
+
+    auto timeIt = [&](const char* name, const std::function<void(int*)>& sortFn) {
+        std::vector<int> x = base;
+        auto t0 = std::chrono::steady_clock::now();
+        sortFn(x.data());
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << "  " << std::left << std::setw(28) << name
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms"
+                  << (x == expect ? "" : "  [MISMATCH]") << "\n";
+    };
+    timeIt("n/2^k (课件示例)", [n](int* a) {
+        std::vector<int> inc;
+        for (int d = n / 2; d >= 1; d /= 2) inc.push_back(d);
+        ShellSort(a, n, inc.data(), static_cast<int>(inc.size()));
+    });
+    timeIt("Ciura", [n](int* a) { ShellSort(a, n, ShellGapSequence::Ciura); });
+    timeIt("Tokuda", [n](int* a) { ShellSort(a, n, ShellGapSequence::Tokuda); });
+    timeIt("Sedgewick", [n](int* a) { ShellSort(a, n, ShellGapSequence::Sedgewick); });
+    timeIt("ShellSortInPlace (Auto)", [n](int* a) { ShellSortInPlace(a, n); });
+}
+
 // 一个简单的示例 main：演示同一组输入分别用直接插入、希尔排序后的结果
+// 定义 SORT_BENCHMARK_NO_MAIN 时不编译演示 main，供 排序性能测试.cpp 直接包含本文件
+#ifndef SORT_BENCHMARK_NO_MAIN
 int main() {
     int n;
     std::cout << "Input n and n integers:\n";
@@ -112,5 +272,18 @@ int main() {
     ShellSort(c.data(), n, inc.data(), static_cast<int>(inc.size()));
     PrintArray(c.data(), n, "[ShellSort] (课件 9.2.2 第23-27页)");
 
+    std::vector<int> d = a;
+    int gaps[kMaxShellGaps];
+    int t = MakeShellGaps(n, ShellGapSequence::Auto, gaps);
+    ShellSortInPlace(d.data(), n);
+    std::cout << "[MakeShellGaps] Auto 增量序列:";
+    for (int k = 0; k < t; ++k) std::cout << ' ' << gaps[k];
+    std::cout << "\n";
+    PrintArray(d.data(), n, "[ShellSortInPlace] (内置增量序列 + 无边界检查插入)");
+
+    std::cout << "[Benchmark] n = " << (1 << 20) << "\n";
+    BenchmarkShellSort(1 << 20);
+
     return 0;
 }
+#endif
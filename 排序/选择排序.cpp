@@ -4,6 +4,8 @@
 // 本文件实现：
 //   1) 简单选择排序 SimpleSelectionSort（9.4.1，课件第41-43页）
 //   2) 堆排序 HeapSort（9.4.2，课件第45-51页，按“大顶堆”实现升序排序）
+//   3) 由 SiftDown 推广出的优先队列：d 叉堆 DaryHeap（BinaryHeap / QuaternaryHeap）、
+//      支持 decrease-key 的索引堆 IndexedHeap、用于 k 路归并的败者树 TournamentTree
 //
 // 选择类排序的思想：每趟从无序区“选择”关键字最小/最大元素放入有序区（课件第10页）。
 //
@@ -23,6 +25,14 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 template <class ElemType>
 void PrintArray(const ElemType elem[], int n, const std::string& title) {
@@ -110,6 +120,393 @@ void HeapSort(ElemType elem[], int n) {
     }
 }
 
+// ============================================================
+// 9.4.2（续）由 SiftDown 推广出的优先队列
+// ------------------------------------------------------------
+// 堆排序里的“筛选”其实就是优先队列的两个基本操作：
+//   - 取出堆顶后把末尾元素放到根、自上而下筛选（SiftDown），即 pop；
+//   - 新元素放到末尾、自下而上与双亲比较并上移（SiftUp），即 push；
+//   - BuildMaxHeap 自下而上逐个筛选，O(n) 建堆（课件第51页）。
+// 最小生成树的 Prim、最短路径的 Dijkstra、哈夫曼树的构造都要反复“选出最小者”，
+// 下面把这些操作整理成可复用的模板（比较器与元素类型均可定制，元素只需可移动）：
+//   1) DaryHeap<T, Compare, D>：d 叉堆，D = 2 即二叉堆 BinaryHeap，D = 4 即 QuaternaryHeap；
+//   2) IndexedHeap<Key, Compare, D>：按编号 0..n-1 管理元素，支持 changeKey（含 decrease-key）与 erase；
+//   3) TournamentTree<T, Compare>：败者树，k 路归并时每输出一个元素只需沿一条路径重赛。
+// 比较器的约定与 std::priority_queue 一致：Compare = std::less<T> 时堆顶为最大元素（大顶堆，
+// 与上面的 HeapSort 相同）；取最小元素用 std::greater<T>。
+//
+// 与 SiftDown 的区别：筛选时采用“挖坑”写法，被筛选的元素先取出，沿途只做单向移动，
+// 最后一次性放入最终位置（一次 swap 是 3 次移动，挖坑每层只需 1 次）。
+// 说明：本目录每个 .cpp 独立编译，图与哈夫曼树的示例程序仍各自保留原有实现；
+// 需要时可以把本节代码原样复制过去，接口不依赖本文件的其他部分。
+// ============================================================
+
+// ------------------------------------------------------------
+// d 叉堆：结点 i 的孩子为 D*i+1 .. D*i+D，双亲为 (i-1)/D
+// 4 叉堆的高度只有二叉堆的一半，筛选时 4 个孩子在内存中相邻（通常落在同一缓存行），
+// 用稍多的比较换更少的层数与缓存缺失；堆的规模超出缓存后通常比二叉堆快（小规模时两者相当）。
+// ------------------------------------------------------------
+template <class T, class Compare = std::less<T>, int D = 2>
+class DaryHeap {
+    static_assert(D >= 2, "DaryHeap: D 至少为 2");
+
+public:
+    explicit DaryHeap(Compare comp = Compare()) : comp_(comp) {}
+
+    // 由已有元素 O(n) 建堆（同 BuildMaxHeap：从最后一个非叶结点起逐个筛选）
+    explicit DaryHeap(std::vector<T> elems, Compare comp = Compare())
+        : data_(std::move(elems)), comp_(comp) {
+        for (int i = (size() - 2) / D; i >= 0; --i) siftDown(i);
+    }
+
+    bool empty() const { return data_.empty(); }
+    int size() const { return static_cast<int>(data_.size()); }
+    void reserve(int n) { data_.reserve(n); }
+    void clear() { data_.clear(); }
+    const T& top() const { return data_.front(); }
+
+    void push(T value) {
+        data_.push_back(std::move(value));
+        siftUp(size() - 1);
+    }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        data_.emplace_back(std::forward<Args>(args)...);
+        siftUp(size() - 1);
+    }
+
+    // 弹出并返回堆顶
+    T pop() {
+        T result = std::move(data_.front());
+        if (size() > 1) {
+            data_.front() = std::move(data_.back());
+            data_.pop_back();
+            siftDown(0);
+        } else {
+            data_.pop_back();
+        }
+        return result;
+    }
+
+    // 弹出堆顶并压入 value，只筛选一次（k 路归并、Top-K 等场景比 pop + push 少一半工作）
+    T replaceTop(T value) {
+        T result = std::move(data_.front());
+        data_.front() = std::move(value);
+        siftDown(0);
+        return result;
+    }
+
+private:
+    void siftUp(int i) {
+        T value = std::move(data_[i]);
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!comp_(data_[parent], value)) break;
+            data_[i] = std::move(data_[parent]);
+            i = parent;
+        }
+        data_[i] = std::move(value);
+    }
+
+    void siftDown(int i) {
+        const int n = size();
+        T value = std::move(data_[i]);
+        while (true) {
+            int first = D * i + 1;
+            if (first >= n) break;
+            int last = std::min(first + D, n);
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (comp_(data_[best], data_[c])) best = c;
+            }
+            if (!comp_(value, data_[best])) break;
+            data_[i] = std::move(data_[best]);
+            i = best;
+        }
+        data_[i] = std::move(value);
+    }
+
+    std::vector<T> data_;
+    Compare comp_;
+};
+
+template <class T, class Compare = std::less<T>>
+using BinaryHeap = DaryHeap<T, Compare, 2>;
+
+template <class T, class Compare = std::less<T>>
+using QuaternaryHeap = DaryHeap<T, Compare, 4>;
+
+// ------------------------------------------------------------
+// 索引堆：元素以编号 id ∈ [0, capacity) 标识，pos_[id] 记录其在堆中的位置，
+// 因而能在 O(log_D n) 内修改任意元素的关键字或删除它。
+// Dijkstra / Prim 中“松弛后距离变小”就是 changeKey 的上移情形（decrease-key），
+// 每个顶点在堆中只出现一次，不必像 std::priority_queue 那样重复压入后再跳过过期项。
+// ------------------------------------------------------------
+template <class Key, class Compare = std::less<Key>, int D = 4>
+class IndexedHeap {
+    static_assert(D >= 2, "IndexedHeap: D 至少为 2");
+
+public:
+    explicit IndexedHeap(int capacity, Compare comp = Compare())
+        : key_(capacity), pos_(capacity, -1), comp_(comp) {
+        heap_.reserve(capacity);
+    }
+
+    bool empty() const { return heap_.empty(); }
+    int size() const { return static_cast<int>(heap_.size()); }
+    int capacity() const { return static_cast<int>(pos_.size()); }
+    bool contains(int id) const { return pos_[id] != -1; }
+    int topId() const { return heap_.front(); }
+    const Key& topKey() const { return key_[heap_.front()]; }
+    const Key& key(int id) const { return key_[id]; }
+
+    // 插入编号 id（调用前 id 不在堆中）
+    void push(int id, Key k) {
+        if (contains(id)) throw std::logic_error("IndexedHeap::push: id already in heap");
+        key_[id] = std::move(k);
+        pos_[id] = size();
+        heap_.push_back(id);
+        siftUp(pos_[id]);
+    }
+
+    // 修改 id 的关键字（调用前 id 须在堆中）：向堆顶方向变化时上移，反之下移
+    void changeKey(int id, Key k) {
+        if (!contains(id)) throw std::logic_error("IndexedHeap::changeKey: id not in heap");
+        bool promote = comp_(key_[id], k);      // 新关键字“更优先”
+        key_[id] = std::move(k);
+        if (promote) siftUp(pos_[id]);
+        else siftDown(pos_[id]);
+    }
+
+    // id 不在堆中则插入，否则修改关键字
+    void pushOrChange(int id, Key k) {
+        if (contains(id)) changeKey(id, std::move(k));
+        else push(id, std::move(k));
+    }
+
+    // 弹出堆顶，返回其编号（关键字仍可用 key(id) 读取）
+    int pop() {
+        int id = heap_.front();
+        removeAt(0);
+        return id;
+    }
+
+    void erase(int id) {
+        if (contains(id)) removeAt(pos_[id]);
+    }
+
+private:
+    void removeAt(int i) {
+        int id = heap_[i];
+        int last = heap_.back();
+        heap_.pop_back();
+        pos_[id] = -1;
+        if (i < size()) {
+            heap_[i] = last;
+            pos_[last] = i;
+            // 末尾元素放到 i 处后可能需要上移也可能需要下移
+            siftUp(i);
+            siftDown(pos_[last]);
+        }
+    }
+
+    void place(int i, int id) {
+        heap_[i] = id;
+        pos_[id] = i;
+    }
+
+    void siftUp(int i) {
+        int id = heap_[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!comp_(key_[heap_[parent]], key_[id])) break;
+            place(i, heap_[parent]);
+            i = parent;
+        }
+        place(i, id);
+    }
+
+    void siftDown(int i) {
+        const int n = size();
+        int id = heap_[i];
+        while (true) {
+            int first = D * i + 1;
+            if (first >= n) break;
+            int last = std::min(first + D, n);
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (comp_(key_[heap_[best]], key_[heap_[c]])) best = c;
+            }
+            if (!comp_(key_[id], key_[heap_[best]])) break;
+            place(i, heap_[best]);
+            i = best;
+        }
+        place(i, id);
+    }
+
+    std::vector<Key> key_;
+    std::vector<int> heap_;
+    std::vector<int> pos_;
+    Compare comp_;
+};
+
+// ------------------------------------------------------------
+// 败者树（锦标赛树）TournamentTree：k 路归并时从 k 个序列的当前头元素中选出最优者
+//   - 叶子 0..k-1 对应 k 个参赛序列，内部结点 loser_[1..k-1] 记录该场比赛的败者，loser_[0] 为冠军；
+//   - 冠军输出后，其所在叶子换上该序列的下一个元素，只需沿“叶子 → 根”与沿途记录的败者各比一次，
+//     共 ceil(log2 k) 次比较；二叉堆的 replaceTop 每层要比较两次（两个孩子之间、孩子与自己）。
+// 序列耗尽的叶子视为“永远失败”；所有叶子都耗尽时 empty() 为真。
+// 比较器约定同上：Compare = std::less<T> 时优先输出较大者，升序归并请用 std::greater<T>。
+// 关键字相同时编号小的叶子胜出，因此按输入次序编号即可得到稳定的归并。
+// ------------------------------------------------------------
+template <class T, class Compare = std::less<T>>
+class TournamentTree {
+public:
+    // k 个叶子初始都为“已耗尽”，用 set 设置初值后调用 build
+    explicit TournamentTree(int k, Compare comp = Compare())
+        : k_(k), loser_(std::max(1, k), 0), key_(k), live_(k, 0), comp_(comp) {
+        if (k <= 0) throw std::invalid_argument("TournamentTree: k must be positive");
+    }
+
+    void set(int leaf, T value) {
+        key_[leaf] = std::move(value);
+        live_[leaf] = 1;
+    }
+
+    void build() {
+        loser_[0] = k_ == 1 ? 0 : buildFrom(1);
+    }
+
+    bool empty() const { return !live_[loser_[0]]; }
+    int winner() const { return loser_[0]; }
+    const T& top() const { return key_[loser_[0]]; }
+
+    // 冠军所在序列给出下一个元素
+    void replaceTop(T value) {
+        key_[loser_[0]] = std::move(value);
+        replay(loser_[0]);
+    }
+
+    // 冠军所在序列已耗尽
+    void exhaustTop() {
+        live_[loser_[0]] = 0;
+        replay(loser_[0]);
+    }
+
+private:
+    // a 是否胜过 b
+    bool beats(int a, int b) const {
+        if (!live_[a]) return false;
+        if (!live_[b]) return true;
+        if (comp_(key_[b], key_[a])) return true;
+        if (comp_(key_[a], key_[b])) return false;
+        return a < b;
+    }
+
+    int buildFrom(int node) {
+        if (node >= k_) return node - k_;
+        int l = buildFrom(2 * node);
+        int r = buildFrom(2 * node + 1);
+        if (beats(l, r)) { loser_[node] = r; return l; }
+        loser_[node] = l;
+        return r;
+    }
+
+    void replay(int leaf) {
+        int w = leaf;
+        for (int node = (leaf + k_) / 2; node >= 1; node /= 2) {
+            if (beats(loser_[node], w)) std::swap(loser_[node], w);
+        }
+        loser_[0] = w;
+    }
+
+    int k_;
+    std::vector<int> loser_;
+    std::vector<T> key_;
+    std::vector<char> live_;
+    Compare comp_;
+};
+
+// 把 k 个按 comp 有序（升序时 comp 为 std::less）的序列稳定地归并成一个
+template <class T, class Compare = std::less<T>>
+std::vector<T> MergeSortedRuns(const std::vector<std::vector<T>>& runs, Compare comp = Compare()) {
+    std::vector<T> out;
+    if (runs.empty()) return out;
+    std::size_t total = 0;
+    for (const auto& r : runs) total += r.size();
+    out.reserve(total);
+
+    // 败者树的比较器是“优先输出者更大”，升序归并需要反过来
+    auto reversed = [comp](const T& a, const T& b) { return comp(b, a); };
+    const int k = static_cast<int>(runs.size());
+    TournamentTree<T, decltype(reversed)> tree(k, reversed);
+    std::vector<std::size_t> next(k, 0);
+    for (int i = 0; i < k; ++i) {
+        if (!runs[i].empty()) {
+            tree.set(i, runs[i][0]);
+            next[i] = 1;
+        }
+    }
+    tree.build();
+    while (!tree.empty()) {
+        int w = tree.winner();
+        out.push_back(tree.top());
+        if (next[w] < runs[w].size()) tree.replaceTop(runs[w][next[w]++]);
+        else tree.exhaustTop();
+    }
+    return out;
+}
+
+// 交替 push/pop 的典型负载（随机插入 n 个，再弹出 n 个同时补入 n/2 个），
+// 比较 BinaryHeap、QuaternaryHeap 与 std::priority_queue
+void BenchmarkPriorityQueues(int n) {
+    std::mt19937 rng(2024);
+    std::vector<int> values(2 * n);
+    for (int& x : values) x = static_cast<int>(rng());
+
+    auto timeIt = [&](const char* name, auto heap) {
+        auto t0 = std::chrono::steady_clock::now();
+        long long checksum = 0;
+        int next = 0;
+        for (int i = 0; i < n; ++i) heap.push(values[next++]);
+        for (int i = 0; i < n; ++i) {
+            checksum += heap.top();
+            heap.pop();
+            if (i % 2 == 0) heap.push(values[next++]);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                  << " ms (checksum " << checksum << ")\n";
+    };
+    timeIt("BinaryHeap          ", BinaryHeap<int, std::greater<int>>());
+    timeIt("QuaternaryHeap      ", QuaternaryHeap<int, std::greater<int>>());
+    timeIt("std::priority_queue ", std::priority_queue<int, std::vector<int>, std::greater<int>>());
+}
+
+// 用 IndexedHeap 做带 decrease-key 的 Dijkstra（邻接表：adj[u] = {(v, w), ...}）
+std::vector<long long> DijkstraWithIndexedHeap(const std::vector<std::vector<std::pair<int, int>>>& adj, int s) {
+    const long long INF = std::numeric_limits<long long>::max();
+    const int n = static_cast<int>(adj.size());
+    std::vector<long long> dist(n, INF);
+    IndexedHeap<long long, std::greater<long long>> heap(n);
+    dist[s] = 0;
+    heap.push(s, 0);
+    while (!heap.empty()) {
+        int u = heap.pop();
+        for (const auto& e : adj[u]) {
+            long long nd = dist[u] + e.second;
+            if (nd < dist[e.first]) {
+                dist[e.first] = nd;
+                heap.pushOrChange(e.first, nd);
+            }
+        }
+    }
+    return dist;
+}
+
+// 定义 SORT_BENCHMARK_NO_MAIN 时不编译演示 main，供 排序性能测试.cpp 直接包含本文件
+#ifndef SORT_BENCHMARK_NO_MAIN
 int main() {
     int n;
     std::cout << "Input n and n integers:\n";
@@ -127,5 +524,34 @@ int main() {
     HeapSort(c.data(), n);
     PrintArray(c.data(), n, "[HeapSort] (课件 9.4.2 第45-51页)");
 
+    // 小顶 4 叉堆：像构造哈夫曼树那样反复取出两个最小权值合并，求带权路径长度 WPL
+    QuaternaryHeap<long long, std::greater<long long>> weights(std::vector<long long>(a.begin(), a.end()));
+    long long wpl = 0;
+    while (weights.size() > 1) {
+        long long x = weights.pop();
+        long long y = weights.pop();
+        wpl += x + y;
+        weights.push(x + y);
+    }
+    std::cout << "[QuaternaryHeap] 以输入为权值反复合并两个最小者，合并代价之和（即 WPL）= " << wpl << "\n";
+
+    // 败者树 k 路归并
+    std::vector<std::vector<int>> runs = {{1, 4, 9}, {2, 3, 10, 11}, {}, {0, 5, 6, 7, 8}};
+    std::vector<int> merged = MergeSortedRuns(runs);
+    PrintArray(merged.data(), static_cast<int>(merged.size()), "[TournamentTree] 4 路归并 {1,4,9} {2,3,10,11} {} {0,5,6,7,8}");
+
+    // 索引堆上的 Dijkstra
+    std::vector<std::vector<std::pair<int, int>>> adj(5);
+    adj[0] = {{1, 10}, {3, 30}, {4, 100}};
+    adj[1] = {{2, 50}};
+    adj[2] = {{4, 10}};
+    adj[3] = {{2, 20}, {4, 60}};
+    std::vector<long long> dist = DijkstraWithIndexedHeap(adj, 0);
+    PrintArray(dist.data(), static_cast<int>(dist.size()), "[IndexedHeap] Dijkstra 源点 0 到各顶点的最短距离");
+
+    std::cout << "[Benchmark] n = " << (1 << 20) << "\n";
+    BenchmarkPriorityQueues(1 << 20);
+
     return 0;
 }
+#endif
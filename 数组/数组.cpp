@@ -9,6 +9,9 @@
  *      - Array(const Array&)           // 复制构造
  *      - Array& operator=(const Array&)// 赋值运算
  *      - int Locate(int, va_list&)     // 私有：下标→线性位置
+ *   3) 扩展：编译期维数的 Array<ElemType, Rank>（constexpr 步长、变参模板下标、
+ *      不复制的跨步视图 ArrayView、64 字节对齐存储），供三维网格模板计算使用。
+ *      课件版即 Array<ElemType>（Rank 缺省为 0，表示维数在运行时给出）。
  *
  * 约定与实现细节（和课件一致）：
  *   • 存储采用行优先（Row-major），即最右边下标变化最快
@@ -28,12 +31,26 @@
 #include <stdexcept>   // std::out_of_range, std::bad_alloc
 #include <iomanip>     // std::setw
 #include <utility>     // std::swap
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>     // std::uintptr_t
+#include <limits>
+#include <memory>      // std::uninitialized_value_construct_n, std::destroy_n
+#include <new>         // std::align_val_t
+#include <string>
+#include <type_traits>
+
+// Rank > 0 为编译期维数版本（见文末扩展部分）；Rank = 0 为课件版，维数在构造时给出
+template <class ElemType, int Rank = 0>
+class Array;
 
 /***************
  * Array 类模板
  ***************/
 template <class ElemType>
-class Array {
+class Array<ElemType, 0> {
 protected:
     // 数据成员 —— 与课件一致（见 P20）：
     ElemType *base;   // 数组元素基址
@@ -195,6 +212,279 @@ public:
     }
 };
 
+/*********************************************
+ * Array<ElemType, Rank>：编译期维数的 N 维数组
+ *
+ * 课件版 Array 每次访问都要经 va_list 解码下标、逐维检查越界并循环累加
+ * constants[]，编译器既无法内联也无法向量化。这里把维数 Rank 作为模板参数：
+ *   • constants（步长）由 constexpr 的 RowMajorStrides 求得，仍是 P14 的
+ *     c[i] = ∏_{k>i} b[k]；最右维步长恒为 1，编译期即已知。
+ *   • operator()(i, j, k) 为变参模板，定长循环在 -O2 下展开为一条乘加链
+ *     i*c0 + j*c1 + k，不做越界检查（需要检查时用 At()）。
+ *   • ArrayView 是不拥有存储的跨步视图：Sub 取子块、Strided 隔点取样、
+ *     Slice<D> 固定第 D 维降一维，都只改基址/长度/步长，不复制元素。
+ *   • 存储按 64 字节（缓存行）对齐分配，便于 SIMD 对齐访问。
+ * 下标同样从 0 开始；长度与偏移用 size_t/ptrdiff_t，可超过 int 范围。
+ *********************************************/
+
+struct Range {          // 半开区间 [begin, end)
+    int begin, end;
+};
+
+// 行优先步长（P14）：c[Rank-1] = 1，c[i] = b[i+1] * c[i+1]
+template <int Rank>
+constexpr std::array<std::ptrdiff_t, Rank> RowMajorStrides(const std::array<int, Rank> &b) {
+    std::array<std::ptrdiff_t, Rank> c{};
+    c[Rank - 1] = 1;
+    for (int i = Rank - 2; i >= 0; --i) c[i] = c[i + 1] * b[i + 1];
+    return c;
+}
+static_assert(RowMajorStrides<3>({{2, 3, 4}})[0] == 12 && RowMajorStrides<3>({{2, 3, 4}})[1] == 4,
+              "row-major strides are computed at compile time");
+
+// InnerContig=true 表示最右维步长为 1：此时下标计算直接加 k，内层循环是连续访问
+template <class ElemType, int Rank, bool InnerContig = true>
+class ArrayView {
+    static_assert(Rank > 0, "ArrayView rank must be positive.");
+    ElemType *base;
+    std::array<int, Rank> ext;                  // 各维长度
+    std::array<std::ptrdiff_t, Rank> str;       // 各维步长（元素个数）
+
+public:
+    ArrayView(ElemType *b, const std::array<int, Rank> &e, const std::array<std::ptrdiff_t, Rank> &s)
+        : base(b), ext(e), str(s) {}
+
+    template <class... Idx>
+    std::ptrdiff_t Offset(Idx... idx) const {
+        static_assert(sizeof...(Idx) == Rank, "subscript count must equal Rank");
+        const std::ptrdiff_t sub[Rank] = { static_cast<std::ptrdiff_t>(idx)... };
+        std::ptrdiff_t off = InnerContig ? sub[Rank - 1] : sub[Rank - 1] * str[Rank - 1];
+        for (int d = 0; d < Rank - 1; ++d) off += sub[d] * str[d];
+        return off;
+    }
+
+    // 不检查越界的元素访问
+    template <class... Idx>
+    ElemType &operator()(Idx... idx) const { return base[Offset(idx...)]; }
+
+    // 检查越界的元素访问（越界抛出 std::out_of_range，同课件版）
+    template <class... Idx>
+    ElemType &At(Idx... idx) const {
+        static_assert(sizeof...(Idx) == Rank, "subscript count must equal Rank");
+        const long long sub[Rank] = { static_cast<long long>(idx)... };
+        for (int d = 0; d < Rank; ++d)
+            if (sub[d] < 0 || sub[d] >= ext[d])
+                throw std::out_of_range("Subscript out of range on dimension " + std::to_string(d) + ".");
+        return base[Offset(idx...)];
+    }
+
+    int Extent(int d) const { return ext[d]; }
+    std::ptrdiff_t Stride(int d) const { return str[d]; }
+    std::size_t Size() const {
+        std::size_t n = 1;
+        for (int d = 0; d < Rank; ++d) n *= static_cast<std::size_t>(ext[d]);
+        return n;
+    }
+    ElemType *Data() const { return base; }
+
+    // 子块视图：每维取 [begin, end)
+    template <class... R>
+    ArrayView Sub(R... r) const {
+        static_assert(sizeof...(R) == Rank, "range count must equal Rank");
+        const Range rg[Rank] = { r... };
+        ArrayView v(*this);
+        for (int d = 0; d < Rank; ++d) {
+            if (rg[d].begin < 0 || rg[d].begin > rg[d].end || rg[d].end > ext[d])
+                throw std::out_of_range("Sub range invalid on dimension " + std::to_string(d) + ".");
+            v.base += rg[d].begin * str[d];
+            v.ext[d] = rg[d].end - rg[d].begin;
+        }
+        return v;
+    }
+
+    // 隔点取样视图：第 d 维每 step[d] 个取一个
+    template <class... S>
+    ArrayView<ElemType, Rank, false> Strided(S... step) const {
+        static_assert(sizeof...(S) == Rank, "step count must equal Rank");
+        const int st[Rank] = { static_cast<int>(step)... };
+        std::array<int, Rank> e = ext;
+        std::array<std::ptrdiff_t, Rank> s = str;
+        for (int d = 0; d < Rank; ++d) {
+            if (st[d] <= 0) throw std::out_of_range("Stride step must be positive.");
+            e[d] = (ext[d] + st[d] - 1) / st[d];
+            s[d] *= st[d];
+        }
+        return ArrayView<ElemType, Rank, false>(base, e, s);
+    }
+
+    // 固定第 D 维的下标为 index，得到 Rank-1 维视图（如三维网格的一个平面）
+    template <int D>
+    ArrayView<ElemType, Rank - 1, InnerContig && D != Rank - 1> Slice(int index) const {
+        static_assert(Rank > 1 && D >= 0 && D < Rank, "Slice dimension invalid");
+        if (index < 0 || index >= ext[D]) throw std::out_of_range("Slice index out of range.");
+        std::array<int, Rank - 1> e{};
+        std::array<std::ptrdiff_t, Rank - 1> s{};
+        for (int d = 0, k = 0; d < Rank; ++d)
+            if (d != D) { e[k] = ext[d]; s[k] = str[d]; ++k; }
+        return ArrayView<ElemType, Rank - 1, InnerContig && D != Rank - 1>(base + index * str[D], e, s);
+    }
+};
+
+template <class ElemType, int Rank>
+class Array {
+    static_assert(Rank > 0, "Array rank must be positive.");
+    static constexpr std::size_t kAlign = alignof(ElemType) > 64 ? alignof(ElemType) : 64;
+
+    ElemType *base;
+    std::array<int, Rank> bounds;
+    std::array<std::ptrdiff_t, Rank> constants;
+    std::size_t total;
+
+    // 按 kAlign 对齐分配并值初始化（基础类型置零，同课件版 new ElemType[total]()）
+    void allocate_() {
+        void *raw = ::operator new(total * sizeof(ElemType), std::align_val_t(kAlign));
+        base = static_cast<ElemType *>(raw);
+        try { std::uninitialized_value_construct_n(base, total); }
+        catch (...) { ::operator delete(raw, std::align_val_t(kAlign)); base = nullptr; throw; }
+    }
+    void release_() noexcept {
+        if (!base) return;
+        std::destroy_n(base, total);
+        ::operator delete(base, std::align_val_t(kAlign));
+        base = nullptr;
+    }
+
+public:
+    // 构造：依次给出 Rank 个维长，如 Array<double, 3> G(nx, ny, nz)
+    template <class... Len,
+              class = std::enable_if_t<sizeof...(Len) == Rank && (std::is_integral<Len>::value && ...)>>
+    explicit Array(Len... lens) : Array(std::array<int, Rank>{{ static_cast<int>(lens)... }}) {}
+
+    explicit Array(const std::array<int, Rank> &b) : base(nullptr), bounds(b), total(1) {
+        for (int d = 0; d < Rank; ++d) {
+            if (bounds[d] <= 0) throw std::out_of_range("Each dimension length must be positive.");
+            if (total > std::numeric_limits<std::size_t>::max() / sizeof(ElemType) / bounds[d])
+                throw std::overflow_error("Array is too large.");
+            total *= static_cast<std::size_t>(bounds[d]);
+        }
+        constants = RowMajorStrides<Rank>(bounds);
+        allocate_();
+    }
+
+    ~Array() { release_(); }
+
+    Array(const Array &src) : base(nullptr), bounds(src.bounds), constants(src.constants), total(src.total) {
+        void *raw = ::operator new(total * sizeof(ElemType), std::align_val_t(kAlign));
+        base = static_cast<ElemType *>(raw);
+        try { std::uninitialized_copy_n(src.base, total, base); }
+        catch (...) { ::operator delete(raw, std::align_val_t(kAlign)); base = nullptr; throw; }
+    }
+    Array(Array &&src) noexcept
+        : base(src.base), bounds(src.bounds), constants(src.constants), total(src.total) {
+        src.base = nullptr; src.total = 0;
+    }
+    // 复制-交换，兼顾复制与移动赋值
+    Array &operator=(Array src) noexcept {
+        std::swap(base, src.base);
+        std::swap(bounds, src.bounds);
+        std::swap(constants, src.constants);
+        std::swap(total, src.total);
+        return *this;
+    }
+
+    template <class... Idx>
+    ElemType &operator()(Idx... idx) { return base[View().Offset(idx...)]; }
+    template <class... Idx>
+    const ElemType &operator()(Idx... idx) const { return base[View().Offset(idx...)]; }
+    template <class... Idx>
+    ElemType &At(Idx... idx) { return View().At(idx...); }
+    template <class... Idx>
+    const ElemType &At(Idx... idx) const { return View().At(idx...); }
+
+    ArrayView<ElemType, Rank> View() { return ArrayView<ElemType, Rank>(base, bounds, constants); }
+    ArrayView<const ElemType, Rank> View() const {
+        return ArrayView<const ElemType, Rank>(base, bounds, constants);
+    }
+    template <class... R>
+    ArrayView<ElemType, Rank> Sub(R... r) { return View().Sub(r...); }
+    template <class... R>
+    ArrayView<const ElemType, Rank> Sub(R... r) const { return View().Sub(r...); }
+
+    static constexpr int Dimensions() { return Rank; }
+    int Length(int d) const {
+        if (d < 0 || d >= Rank) throw std::out_of_range("dimension index invalid.");
+        return bounds[d];
+    }
+    std::size_t Size() const { return total; }
+    ElemType *Data() { return base; }
+    const ElemType *Data() const { return base; }
+    void Fill(const ElemType &v) { std::fill_n(base, total, v); }
+
+    void PrintShape(std::ostream &os = std::cout) const {
+        os << "shape=(";
+        for (int i = 0; i < Rank; ++i) os << bounds[i] << (i + 1 < Rank ? "," : "");
+        os << ")\n";
+    }
+};
+
+// 三维 7 点 Jacobi 迭代的一步：out = (中心 + 六邻居) / 7，边界保持不变。
+// 直接用 operator() 书写；最右维步长编译期为 1，内层 k 循环是连续访问，
+// -O3（或 -O2 -ftree-vectorize）下被自动向量化。
+template <class ElemType>
+void JacobiStep7(const Array<ElemType, 3> &in, Array<ElemType, 3> &out) {
+    const int nx = in.Length(0), ny = in.Length(1), nz = in.Length(2);
+    const ElemType w = ElemType(1) / ElemType(7);
+    for (int i = 1; i < nx - 1; ++i)
+        for (int j = 1; j < ny - 1; ++j)
+            for (int k = 1; k < nz - 1; ++k)
+                out(i, j, k) = w * (in(i, j, k) + in(i, j, k - 1) + in(i, j, k + 1) + in(i - 1, j, k)
+                                    + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+}
+
+// 同一计算走课件版 Array（va_list 下标），用作对照
+template <class ElemType>
+void JacobiStep7(const Array<ElemType> &in, Array<ElemType> &out) {
+    const int nx = in.Length(0), ny = in.Length(1), nz = in.Length(2);
+    const ElemType w = ElemType(1) / ElemType(7);
+    for (int i = 1; i < nx - 1; ++i)
+        for (int j = 1; j < ny - 1; ++j)
+            for (int k = 1; k < nz - 1; ++k)
+                out(i, j, k) = w * (in(i, j, k) + in(i, j, k - 1) + in(i, j, k + 1) + in(i - 1, j, k)
+                                    + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+}
+
+void BenchmarkStencil(int n, int sweeps) {
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    Array<double> oldA(3, n, n, n), oldB(3, n, n, n);
+    Array<double, 3> newA(n, n, n), newB(n, n, n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            for (int k = 0; k < n; ++k) {
+                double v = ((i * 31 + j * 17 + k * 7) % 101) / 100.0;
+                oldA(i, j, k) = oldB(i, j, k) = newA(i, j, k) = newB(i, j, k) = v;
+            }
+
+    auto t0 = Clock::now();
+    for (int s = 0; s < sweeps; ++s) {                 // A→B、B→A 交替，结果留在 A 中（sweeps 为偶数）
+        if (s % 2 == 0) JacobiStep7(oldA, oldB); else JacobiStep7(oldB, oldA);
+    }
+    auto t1 = Clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        if (s % 2 == 0) JacobiStep7(newA, newB); else JacobiStep7(newB, newA);
+    }
+    auto t2 = Clock::now();
+
+    double diff = 0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            for (int k = 0; k < n; ++k) diff = std::max(diff, std::fabs(oldA(i, j, k) - newA(i, j, k)));
+    std::cout << "  " << n << "^3 网格 7 点 Jacobi x" << sweeps << ": 课件版 Array " << ms(t0, t1)
+              << " ms, Array<double,3> " << ms(t1, t2) << " ms, max|Δ|=" << diff << "\n";
+}
+
 /*********************************************
  *                示例与测试
  * main() 将验证一维 / 二维 / 三维情形下的
@@ -256,6 +546,31 @@ int main() {
         C = A2;                 // 赋值
         std::cout << "[拷贝/赋值] B(2,3) = " << B(2,3) << ", C(2,3) = " << C(2,3) << "\n";
 
+        // === 5) 编译期维数 Array<int,3>：下标在编译期确定步长，访问无 va_list
+        Array<int, 3> G(p, q, r);
+        for (int i = 0; i < p; ++i)
+            for (int j = 0; j < q; ++j)
+                for (int k = 0; k < r; ++k)
+                    G(i, j, k) = (i+1)*100 + (j+1)*10 + (k+1);
+        std::cout << "\n[Array<int,3>] "; G.PrintShape();
+        std::cout << "G(1,2,3) = " << G(1,2,3) << "，&G(1,2,3)-&G(0,0,0) = " << (&G(1,2,3) - &G(0,0,0))
+                  << "，首址 64 字节对齐: " << (reinterpret_cast<std::uintptr_t>(G.Data()) % 64 == 0 ? "是" : "否") << "\n";
+        // 子块视图：第 1 页、行 [1,3)、列 [1,4)，修改会写回 G
+        auto sub = G.Sub(Range{1, 2}, Range{1, 3}, Range{1, 4});
+        sub(0, 0, 0) = -1;
+        std::cout << "Sub 视图 " << sub.Extent(0) << "x" << sub.Extent(1) << "x" << sub.Extent(2)
+                  << "，写 sub(0,0,0) 后 G(1,1,1) = " << G(1,1,1) << "\n";
+        // 平面切片 + 隔点取样：G(0, *, 0..r step 2)
+        auto plane = G.View().Slice<0>(0);
+        auto everyOther = plane.Strided(1, 2);
+        std::cout << "Slice<0>(0).Strided(1,2) 的第 2 行:";
+        for (int k = 0; k < everyOther.Extent(1); ++k) std::cout << " " << everyOther(2, k);
+        std::cout << "\n";
+        try { G.At(p, 0, 0); } catch (const std::out_of_range &e) { std::cout << "At 越界检查: " << e.what() << "\n"; }
+
+        std::cout << "\n[模板计算性能对比]\n";
+        BenchmarkStencil(96, 10);
+
         // 越界演示（可注释掉观察）：应抛出异常
         // std::cout << A2(m, 0) << "\n"; // m 越界
     }
@@ -268,6 +583,7 @@ int main() {
 /*
 编译建议：
   g++ -std=c++17 -O2 数组.cpp -o 数组
+  （模板计算希望自动向量化时用 -O3 或 -O2 -ftree-vectorize，可加 -march=native）
 
 运行输出要点（示例）：
   [一维] shape=(10)
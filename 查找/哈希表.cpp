@@ -9,16 +9,36 @@
 //   2. 三种典型哈希函数形式（平方取中法、除留余数法、伪随机法接口）；
 //   3. 开放定址法（线性探测、二次探测），对应第 76–78 页；
 //   4. 链地址法（分离链接法），对应第 79–80 页；
-//   5. 简单展示“装载因子”和“扩容”思想，对应第 81–82 页。
+//   5. 简单展示“装载因子”和“扩容”思想，对应第 81–82 页；
+//   6. Swiss Table 风格的分组探测哈希表（控制字节与关键字分离、SIMD 组内比较）；
+//   7. 不取模的快速哈希（斐波那契散列、wyhash 风格混合）与可插拔的哈希函数对象；
+//   8. 链地址法的“结点池”版本（slab 分配 + 下标链接）与链长直方图。
 //
 // 注意：
-//   这里的实现以 int 类型关键字为例，便于与课件中的数字示例对应。
+//   三种哈希表都是 Key / Value / Hash / KeyEqual 的模板，
+//   默认参数（int 关键字、无附加信息、除留余数法）与课件中的数字示例对应。
 
 #include <iostream>
 #include <vector>
 #include <list>
 #include <cmath>
 #include <random>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_GROUP_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HASH_GROUP_NEON 1
+#endif
 
 //-------------------------------------------------------------
 // 一、哈希函数实现（对应 8.4.2）
@@ -72,6 +92,131 @@ size_t hashPseudoRandom(int key, size_t tableSize)
     return static_cast<size_t>(dist(rng));
 }
 
+//-------------------------------------------------------------
+// 一（续）、不用取模的快速哈希函数
+//-------------------------------------------------------------
+//
+// 除留余数法每次都要做一次整数除法（几十个时钟周期），
+// 并且对表长的选取有要求（素数）。下面两种方法只用乘法与移位：
+//   - 乘法散列 / 斐波那契散列：key * 2^64/φ，取乘积的高位；
+//   - wyhash 风格的混合函数：64×64→128 位乘法后高低两半异或，
+//     再用“乘法取高位”把 64 位哈希值映射到 [0, tableSize)。
+
+/**
+ * @brief 64×64→128 位乘法，返回高低 64 位的异或（wyhash 中的 wymix）
+ */
+inline uint64_t hashWyMix(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    // 没有 128 位整数时，拆成 32 位分量手工相乘
+    uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+    uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+    uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    uint64_t lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+    uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
+
+/**
+ * @brief 乘法取高位：把 64 位哈希值均匀映射到 [0, range)，代替 h % range
+ */
+inline size_t hashReduceRange(uint64_t h, size_t range)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<size_t>((static_cast<__uint128_t>(h) * range) >> 64);
+#else
+    return static_cast<size_t>(h % range);
+#endif
+}
+
+/**
+ * @brief 斐波那契散列：H(key) = (key * 2^64/φ) >> (64 - k)，其中 tableSize = 2^k
+ *
+ * 2^64/φ ≈ 11400714819323198485，乘积的高位受 key 的每一位影响，
+ * 连续的 key 会被打散到整张表上。要求 tableSize 为 2 的幂。
+ */
+size_t hashFibonacci(uint64_t key, size_t tableSize)
+{
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < tableSize)
+        ++bits;
+    if (bits == 0)
+        return 0;
+    return static_cast<size_t>((key * 11400714819323198485ULL) >> (64 - bits));
+}
+
+/**
+ * @brief wyhash 风格的 64 位关键字哈希，tableSize 可以是任意正整数
+ */
+size_t hashWy64(uint64_t key, size_t tableSize)
+{
+    uint64_t h = hashWyMix(key ^ 0xA0761D6478BD642FULL, 0xE7037ED1A0B428DBULL);
+    return hashReduceRange(h, tableSize);
+}
+
+//-------------------------------------------------------------
+// 一（续二）、可插拔的哈希函数对象
+//-------------------------------------------------------------
+//
+// 下面的哈希表模板都通过 Hash 模板参数计算“完整的”哈希值（size_t），
+// 再由表自身映射到下标，因此可以自由替换哈希函数。
+
+/**
+ * @brief 默认哈希：整数关键字取绝对值，再由表做 % m，与 hashModPrime 完全一致
+ */
+template <class Key>
+struct ModPrimeHash
+{
+    size_t operator()(const Key &key) const
+    {
+        if constexpr (std::is_integral<Key>::value)
+        {
+            // 用无符号取负求 |key|，避免最小负数取绝对值溢出
+            return key >= 0 ? static_cast<size_t>(key)
+                            : static_cast<size_t>(0) - static_cast<size_t>(key);
+        }
+        else
+        {
+            return std::hash<Key>()(key);
+        }
+    }
+};
+
+/**
+ * @brief 斐波那契（乘法）散列对象：有效信息集中在高位
+ */
+struct FibonacciHash
+{
+    size_t operator()(uint64_t key) const
+    {
+        uint64_t h = key * 11400714819323198485ULL;
+        return static_cast<size_t>(h ^ (h >> 32)); // 把高位折回低位，便于 % m 或取低位
+    }
+};
+
+/**
+ * @brief wyhash 风格的混合哈希对象：高低位都足够随机
+ */
+struct WyHash
+{
+    size_t operator()(uint64_t key) const
+    {
+        return static_cast<size_t>(hashWyMix(key ^ 0xA0761D6478BD642FULL, 0xE7037ED1A0B428DBULL));
+    }
+};
+
+/**
+ * @brief “无附加信息”占位类型：Value 取该类型时，哈希表退化为只存关键字的集合
+ */
+struct NoValue
+{
+};
+
 //-------------------------------------------------------------
 // 二、开放定址哈希表（对应 8.4.3 中“开放定址法/闭域法”）
 //-------------------------------------------------------------
@@ -87,14 +232,16 @@ enum class SlotState
 };
 
 /**
- * @brief 哈希表槽
+ * @brief 哈希表槽：关键字 + 附加信息（记录）+ 状态
  */
+template <class Key, class Value>
 struct HashSlot
 {
-    int key;
+    Key key;
+    Value value;
     SlotState state;
 
-    HashSlot() : key(0), state(SlotState::EMPTY) {}
+    HashSlot() : key(), value(), state(SlotState::EMPTY) {}
 };
 
 /**
@@ -105,8 +252,17 @@ struct HashSlot
  *   - 线性探测：d_i = i
  *   - 二次探测：d_i = i^2
  *
+ * 模板参数：
+ *   - Key / Value：关键字与附加信息，Value 默认为 NoValue（只存关键字）；
+ *   - Hash：返回完整哈希值的函数对象，H(key) = Hash(key) % m，
+ *           默认 ModPrimeHash 与课件的除留余数法一致；
+ *   - KeyEqual：关键字相等比较。
+ *
  * 这里仅支持“插入 + 查找”，删除用“标记删除”的方式。
+ * Value 以移动方式放入槽中，扩容重散列时也是逐个移动，不做拷贝。
  */
+template <class Key = int, class Value = NoValue,
+          class Hash = ModPrimeHash<Key>, class KeyEqual = std::equal_to<Key>>
 class OpenAddressHashTable
 {
 public:
@@ -117,8 +273,11 @@ public:
     };
 
     explicit OpenAddressHashTable(size_t tableSize,
-                                  ProbeType type = ProbeType::LINEAR)
-        : table(tableSize), probeType(type), elemCount(0)
+                                  ProbeType type = ProbeType::LINEAR,
+                                  const Hash &hash = Hash(),
+                                  const KeyEqual &equal = KeyEqual())
+        : table(tableSize), probeType(type), elemCount(0),
+          hasher(hash), keyEqual(equal)
     {
     }
 
@@ -130,7 +289,8 @@ public:
         return static_cast<double>(elemCount) / static_cast<double>(table.size());
     }
 
-    bool insert(int key)
+    // 插入 (key, value)；key 已存在时不覆盖原有的 value
+    bool insert(const Key &key, Value value = Value())
     {
         if (loadFactor() > 0.7)
         {
@@ -139,74 +299,68 @@ public:
         }
 
         size_t m = table.size();
-        size_t h0 = hashModPrime(key, m); // 这里用除留余数法作为基础哈希
+        size_t h0 = hasher(key) % m; // 默认即除留余数法
+        size_t target = kNotFound;   // 探测途中第一个可用的槽
         for (size_t i = 0; i < m; ++i)
         {
             size_t di = probeOffset(i);
             size_t h = (h0 + di) % m;
 
-            if (table[h].state == SlotState::EMPTY ||
-                table[h].state == SlotState::DELETED)
+            if (table[h].state == SlotState::EMPTY)
             {
-                table[h].key = key;
-                table[h].state = SlotState::OCCUPIED;
-                ++elemCount;
-                return true;
+                if (target == kNotFound)
+                    target = h;
+                break; // key 不可能出现在 EMPTY 之后
+            }
+            else if (table[h].state == SlotState::DELETED)
+            {
+                // DELETED 可以复用，但 key 仍可能在后面，需继续探测
+                if (target == kNotFound)
+                    target = h;
             }
-            else if (table[h].state == SlotState::OCCUPIED &&
-                     table[h].key == key)
+            else if (keyEqual(table[h].key, key))
             {
                 // 已存在
                 return true;
             }
         }
-        return false; // 表已满
+        if (target == kNotFound)
+            return false; // 表已满
+
+        table[target].key = key;
+        table[target].value = std::move(value);
+        table[target].state = SlotState::OCCUPIED;
+        ++elemCount;
+        return true;
     }
 
-    bool find(int key) const
+    bool find(const Key &key) const
     {
-        size_t m = table.size();
-        size_t h0 = hashModPrime(key, m);
-        for (size_t i = 0; i < m; ++i)
-        {
-            size_t di = probeOffset(i);
-            size_t h = (h0 + di) % m;
+        return locate(key) != kNotFound;
+    }
 
-            if (table[h].state == SlotState::EMPTY)
-            {
-                // 遇到 EMPTY 说明 key 从未插入过，可提前结束
-                return false;
-            }
-            if (table[h].state == SlotState::OCCUPIED && table[h].key == key)
-            {
-                return true;
-            }
-            // 遇到 DELETED 或其他 key，继续探测
-        }
-        return false;
+    // 查找 key 对应的附加信息，不存在返回 nullptr
+    Value *get(const Key &key)
+    {
+        size_t h = locate(key);
+        return h == kNotFound ? nullptr : &table[h].value;
     }
 
-    bool erase(int key)
+    const Value *get(const Key &key) const
     {
-        size_t m = table.size();
-        size_t h0 = hashModPrime(key, m);
-        for (size_t i = 0; i < m; ++i)
-        {
-            size_t di = probeOffset(i);
-            size_t h = (h0 + di) % m;
+        size_t h = locate(key);
+        return h == kNotFound ? nullptr : &table[h].value;
+    }
 
-            if (table[h].state == SlotState::EMPTY)
-            {
-                return false;
-            }
-            if (table[h].state == SlotState::OCCUPIED && table[h].key == key)
-            {
-                table[h].state = SlotState::DELETED;
-                --elemCount;
-                return true;
-            }
-        }
-        return false;
+    bool erase(const Key &key)
+    {
+        size_t h = locate(key);
+        if (h == kNotFound)
+            return false;
+        table[h].state = SlotState::DELETED;
+        table[h].value = Value(); // 及时释放附加信息占用的资源
+        --elemCount;
+        return true;
     }
 
     void debugPrint() const
@@ -217,7 +371,11 @@ public:
         {
             std::cout << i << ": ";
             if (table[i].state == SlotState::OCCUPIED)
+            {
                 std::cout << table[i].key;
+                if constexpr (!std::is_same<Value, NoValue>::value)
+                    std::cout << " => " << table[i].value;
+            }
             else if (table[i].state == SlotState::DELETED)
                 std::cout << "DELETED";
             else
@@ -228,9 +386,13 @@ public:
     }
 
 private:
-    std::vector<HashSlot> table;
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    std::vector<HashSlot<Key, Value>> table;
     ProbeType probeType;
     size_t elemCount;
+    Hash hasher;
+    KeyEqual keyEqual;
 
     size_t probeOffset(size_t i) const
     {
@@ -246,17 +408,41 @@ private:
         }
     }
 
+    // 沿探测序列查找 key 所在的槽，找不到返回 kNotFound
+    size_t locate(const Key &key) const
+    {
+        size_t m = table.size();
+        size_t h0 = hasher(key) % m;
+        for (size_t i = 0; i < m; ++i)
+        {
+            size_t di = probeOffset(i);
+            size_t h = (h0 + di) % m;
+
+            if (table[h].state == SlotState::EMPTY)
+            {
+                // 遇到 EMPTY 说明 key 从未插入过，可提前结束
+                return kNotFound;
+            }
+            if (table[h].state == SlotState::OCCUPIED && keyEqual(table[h].key, key))
+            {
+                return h;
+            }
+            // 遇到 DELETED 或其他 key，继续探测
+        }
+        return kNotFound;
+    }
+
     // 简单的扩容 & 重新散列（对应第 82 页“扩容的方法”）
     void rehash(size_t newSize)
     {
-        std::vector<HashSlot> oldTable = table;
-        table.assign(newSize, HashSlot());
+        std::vector<HashSlot<Key, Value>> oldTable(newSize);
+        oldTable.swap(table); // 旧表整体移出，不拷贝任何元素
         elemCount = 0;
 
-        for (const auto &slot : oldTable)
+        for (auto &slot : oldTable)
         {
             if (slot.state == SlotState::OCCUPIED)
-                insert(slot.key);
+                insert(slot.key, std::move(slot.value));
         }
     }
 };
@@ -270,44 +456,63 @@ private:
  *
  * 适合大对象/大数据量，因为单个链表上可以挂很多元素，
  * 并且可以灵活替换为红黑树等结构（课件第 79–80 页的说明）。
+ *
+ * 模板参数与 OpenAddressHashTable 相同。
  */
+template <class Key = int, class Value = NoValue,
+          class Hash = ModPrimeHash<Key>, class KeyEqual = std::equal_to<Key>>
 class ChainedHashTable
 {
 public:
-    explicit ChainedHashTable(size_t tableSize)
-        : buckets(tableSize)
+    explicit ChainedHashTable(size_t tableSize,
+                              const Hash &hash = Hash(),
+                              const KeyEqual &equal = KeyEqual())
+        : buckets(tableSize), hasher(hash), keyEqual(equal)
     {
     }
 
-    void insert(int key)
+    // 插入 (key, value)；key 已存在时不覆盖原有的 value
+    void insert(const Key &key, Value value = Value())
     {
-        size_t index = hashModPrime(key, buckets.size());
-        auto &lst = buckets[index];
-        for (int x : lst)
+        auto &lst = buckets[bucketOf(key)];
+        for (const Entry &e : lst)
         {
-            if (x == key)
+            if (keyEqual(e.key, key))
                 return; // 已存在
         }
-        lst.push_front(key);
+        lst.push_front(Entry{key, std::move(value)});
+    }
+
+    bool find(const Key &key) const
+    {
+        return get(key) != nullptr;
     }
 
-    bool find(int key) const
+    // 查找 key 对应的附加信息，不存在返回 nullptr
+    Value *get(const Key &key)
     {
-        size_t index = hashModPrime(key, buckets.size());
-        const auto &lst = buckets[index];
-        for (int x : lst)
+        for (Entry &e : buckets[bucketOf(key)])
         {
-            if (x == key)
-                return true;
+            if (keyEqual(e.key, key))
+                return &e.value;
+        }
+        return nullptr;
+    }
+
+    const Value *get(const Key &key) const
+    {
+        for (const Entry &e : buckets[bucketOf(key)])
+        {
+            if (keyEqual(e.key, key))
+                return &e.value;
         }
-        return false;
+        return nullptr;
     }
 
-    void erase(int key)
+    void erase(const Key &key)
     {
-        size_t index = hashModPrime(key, buckets.size());
-        auto &lst = buckets[index];
-        lst.remove(key);
+        auto &lst = buckets[bucketOf(key)];
+        lst.remove_if([&](const Entry &e) { return keyEqual(e.key, key); });
     }
 
     void debugPrint() const
@@ -316,19 +521,576 @@ public:
         for (size_t i = 0; i < buckets.size(); ++i)
         {
             std::cout << i << ": ";
-            for (int x : buckets[i])
-                std::cout << x << " -> ";
+            for (const Entry &e : buckets[i])
+            {
+                std::cout << e.key;
+                if constexpr (!std::is_same<Value, NoValue>::value)
+                    std::cout << "(" << e.value << ")";
+                std::cout << " -> ";
+            }
             std::cout << "NULL\n";
         }
         std::cout << "\n";
     }
 
+    // 链长直方图：hist[len] = 长度为 len 的桶数，便于调整表长
+    std::vector<size_t> chainLengthHistogram() const
+    {
+        std::vector<size_t> hist(1, 0);
+        for (const auto &lst : buckets)
+        {
+            size_t len = lst.size();
+            if (len >= hist.size())
+                hist.resize(len + 1, 0);
+            ++hist[len];
+        }
+        return hist;
+    }
+
 private:
-    std::vector<std::list<int>> buckets;
+    struct Entry
+    {
+        Key key;
+        Value value;
+    };
+
+    std::vector<std::list<Entry>> buckets;
+    Hash hasher;
+    KeyEqual keyEqual;
+
+    size_t bucketOf(const Key &key) const { return hasher(key) % buckets.size(); }
 };
 
 //-------------------------------------------------------------
- // 四、演示 main
+// 三（续）、结点池 + 下标链接的链地址哈希表
+//-------------------------------------------------------------
+
+/**
+ * @brief 链地址哈希表的“结点池”版本
+ *
+ * std::list 版本的问题：每次插入都 new 一个结点，每次查找沿指针逐个跳转，
+ * 插入/删除反复进行时堆内存碎片化严重，尾延迟变差。
+ *
+ * 这里的做法：
+ *   1. 所有链表结点放在“结点池”中：池由若干个固定大小的 slab（连续数组）组成，
+ *      用完一个再追加一个，已有结点从不搬移；
+ *   2. 结点之间用 32 位下标而不是指针链接，buckets[i] 存放第 i 条链的首结点下标；
+ *   3. 删除的结点挂到空闲链表上，下次插入直接复用，不再向系统申请内存；
+ *   4. rehash 只重新串接下标，结点本身（及其 Value）不移动。
+ *
+ * 对外接口与 ChainedHashTable 相同，另提供 loadFactor / rehash / chainLengthHistogram。
+ */
+template <class Key = int, class Value = NoValue,
+          class Hash = ModPrimeHash<Key>, class KeyEqual = std::equal_to<Key>>
+class PooledChainedHashTable
+{
+public:
+    explicit PooledChainedHashTable(size_t tableSize,
+                                    const Hash &hash = Hash(),
+                                    const KeyEqual &equal = KeyEqual())
+        : buckets(tableSize, kNil), freeHead(kNil), nodeCount(0), elemCount(0),
+          hasher(hash), keyEqual(equal)
+    {
+    }
+
+    size_t size() const { return buckets.size(); }
+
+    // 装载因子 = 元素个数 / 桶数（链地址法中可以大于 1）
+    double loadFactor() const
+    {
+        return static_cast<double>(elemCount) / static_cast<double>(buckets.size());
+    }
+
+    // 插入 (key, value)；key 已存在时不覆盖原有的 value
+    void insert(const Key &key, Value value = Value())
+    {
+        uint32_t &head = buckets[bucketOf(key)];
+        for (uint32_t i = head; i != kNil; i = node(i).next)
+        {
+            if (keyEqual(node(i).key, key))
+                return; // 已存在
+        }
+        uint32_t i = allocNode();
+        Node &nd = node(i);
+        nd.key = key;
+        nd.value = std::move(value);
+        nd.next = head; // 头插，与 ChainedHashTable 的 push_front 一致
+        head = i;
+        ++elemCount;
+    }
+
+    bool find(const Key &key) const
+    {
+        return get(key) != nullptr;
+    }
+
+    // 查找 key 对应的附加信息，不存在返回 nullptr
+    Value *get(const Key &key)
+    {
+        for (uint32_t i = buckets[bucketOf(key)]; i != kNil; i = node(i).next)
+        {
+            if (keyEqual(node(i).key, key))
+                return &node(i).value;
+        }
+        return nullptr;
+    }
+
+    const Value *get(const Key &key) const
+    {
+        for (uint32_t i = buckets[bucketOf(key)]; i != kNil; i = node(i).next)
+        {
+            if (keyEqual(node(i).key, key))
+                return &node(i).value;
+        }
+        return nullptr;
+    }
+
+    void erase(const Key &key)
+    {
+        uint32_t *link = &buckets[bucketOf(key)];
+        while (*link != kNil)
+        {
+            Node &nd = node(*link);
+            if (keyEqual(nd.key, key))
+            {
+                uint32_t i = *link;
+                *link = nd.next; // 从链上摘下
+                freeNode(i);
+                --elemCount;
+                return;
+            }
+            link = &nd.next;
+        }
+    }
+
+    // 改变桶数：只重新串接下标，不移动任何结点
+    void rehash(size_t newBucketCount)
+    {
+        std::vector<uint32_t> old(newBucketCount, kNil);
+        old.swap(buckets);
+        for (uint32_t head : old)
+        {
+            uint32_t i = head;
+            while (i != kNil)
+            {
+                Node &nd = node(i);
+                uint32_t next = nd.next;
+                uint32_t &dst = buckets[bucketOf(nd.key)];
+                nd.next = dst;
+                dst = i;
+                i = next;
+            }
+        }
+    }
+
+    // 链长直方图：hist[len] = 长度为 len 的桶数，便于调整表长
+    std::vector<size_t> chainLengthHistogram() const
+    {
+        std::vector<size_t> hist(1, 0);
+        for (uint32_t head : buckets)
+        {
+            size_t len = 0;
+            for (uint32_t i = head; i != kNil; i = node(i).next)
+                ++len;
+            if (len >= hist.size())
+                hist.resize(len + 1, 0);
+            ++hist[len];
+        }
+        return hist;
+    }
+
+    // 结点池当前容量（slab 个数 × 每 slab 结点数）
+    size_t poolCapacity() const { return slabs.size() * kSlabSize; }
+
+    void debugPrint() const
+    {
+        std::cout << "结点池链地址哈希表（桶数 = " << buckets.size()
+                  << ", 池容量 = " << poolCapacity() << "）\n";
+        for (size_t b = 0; b < buckets.size(); ++b)
+        {
+            std::cout << b << ": ";
+            for (uint32_t i = buckets[b]; i != kNil; i = node(i).next)
+            {
+                std::cout << node(i).key;
+                if constexpr (!std::is_same<Value, NoValue>::value)
+                    std::cout << "(" << node(i).value << ")";
+                std::cout << "[#" << i << "] -> ";
+            }
+            std::cout << "NULL\n";
+        }
+        std::cout << "\n";
+    }
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr unsigned kSlabShift = 10;          // 每个 slab 1024 个结点
+    static constexpr uint32_t kSlabSize = 1u << kSlabShift;
+
+    struct Node
+    {
+        Key key;
+        Value value;
+        uint32_t next; // 链上下一个结点的下标；在空闲链表中则指向下一个空闲结点
+    };
+
+    std::vector<uint32_t> buckets;             // 每条链首结点的下标
+    std::vector<std::unique_ptr<Node[]>> slabs; // 结点池
+    uint32_t freeHead;                          // 空闲链表
+    uint32_t nodeCount;                         // 已经切分出去的结点数
+    size_t elemCount;
+    Hash hasher;
+    KeyEqual keyEqual;
+
+    size_t bucketOf(const Key &key) const { return hasher(key) % buckets.size(); }
+
+    Node &node(uint32_t i) { return slabs[i >> kSlabShift][i & (kSlabSize - 1)]; }
+    const Node &node(uint32_t i) const { return slabs[i >> kSlabShift][i & (kSlabSize - 1)]; }
+
+    uint32_t allocNode()
+    {
+        if (freeHead != kNil)
+        {
+            uint32_t i = freeHead;
+            freeHead = node(i).next;
+            return i;
+        }
+        if (nodeCount == poolCapacity())
+            slabs.emplace_back(new Node[kSlabSize]());
+        return nodeCount++;
+    }
+
+    void freeNode(uint32_t i)
+    {
+        Node &nd = node(i);
+        nd.value = Value(); // 及时释放附加信息占用的资源
+        nd.next = freeHead;
+        freeHead = i;
+    }
+};
+
+// 打印链长直方图（链长: 桶数）
+void printChainHistogram(const std::vector<size_t> &hist)
+{
+    for (size_t len = 0; len < hist.size(); ++len)
+    {
+        if (hist[len] != 0)
+            std::cout << "  链长 " << len << "：" << hist[len] << " 个桶\n";
+    }
+}
+
+//-------------------------------------------------------------
+// 四、分组探测哈希表（Swiss Table 风格，开放定址法的工程化改进）
+//-------------------------------------------------------------
+
+/**
+ * @brief 分组探测的开放定址哈希表
+ *
+ * 与上面的 OpenAddressHashTable 相比：
+ *   1. 槽状态单独存放在“控制字节”数组 ctrl 中，与关键字数组 keys 分离：
+ *        - EMPTY   = 0x80（-128）
+ *        - DELETED = 0xFE（-2）
+ *        - 已占用  = 0x00..0x7F，存放哈希值的低 7 位 H2；
+ *      探测时先只读控制字节，H2 不相等的槽根本不会去读关键字。
+ *   2. 表长固定为 2 的幂，取下标用 & (m - 1) 代替 %；
+ *   3. 以 16 个槽为一“组”，一次用 SSE2 / NEON 指令比较 16 个控制字节，
+ *      组间按三角数序列 g, g+1, g+3, g+6 ... 探测（组数为 2 的幂时可遍历所有组）；
+ *   4. 一个组里只要还有 EMPTY，就说明任何关键字的探测都不会越过该组，
+ *      因此查找失败最多扫描到第一个含 EMPTY 的组为止，不会扫描整张表；
+ *   5. 删除时若本组仍有 EMPTY，可直接置为 EMPTY，否则才留下墓碑 DELETED；
+ *      扩容前若墓碑较多，则按原表长“原地重散列”清理墓碑，而不是盲目翻倍。
+ *
+ * 对外接口与 OpenAddressHashTable 一致：insert / find / get / erase / loadFactor / size。
+ *
+ * 模板参数同 OpenAddressHashTable，但默认哈希为 WyHash：
+ *   表长为 2 的幂时只用到哈希值的一部分位，除留余数法式的“恒等”哈希分布太差。
+ */
+template <class Key = int, class Value = NoValue,
+          class Hash = WyHash, class KeyEqual = std::equal_to<Key>>
+class SwissHashTable
+{
+public:
+    explicit SwissHashTable(size_t tableSize = kGroupWidth,
+                            const Hash &hash = Hash(),
+                            const KeyEqual &equal = KeyEqual())
+        : elemCount(0), deletedCount(0), hasher(hash), keyEqual(equal)
+    {
+        initTable(roundUpCapacity(tableSize));
+    }
+
+    // 表长（槽的个数，总是 2 的幂且不小于 16）
+    size_t size() const { return keys.size(); }
+
+    // 装载因子 = 元素个数 / 表长（墓碑不计入）
+    double loadFactor() const
+    {
+        return static_cast<double>(elemCount) / static_cast<double>(keys.size());
+    }
+
+    // 插入 (key, value)；key 已存在时不覆盖原有的 value
+    bool insert(const Key &key, Value value = Value())
+    {
+        const uint64_t h = mix(key);
+        const int8_t h2 = static_cast<int8_t>(h & 0x7F);
+        size_t target = kNotFound;
+        if (probe(key, h, h2, &target) != kNotFound)
+            return true; // 已存在
+
+        // 已占用 + 墓碑 不超过表长的 7/8，超过则重散列
+        if (target == kNotFound ||
+            (ctrl[target] == kEmpty && (elemCount + deletedCount + 1) * 8 > keys.size() * 7))
+        {
+            // 墓碑占到表长的 1/4 以上：原地清理即可；否则翻倍扩容
+            size_t newSize = (deletedCount * 4 >= keys.size()) ? keys.size() : keys.size() * 2;
+            rehash(newSize);
+            probe(key, h, h2, &target);
+        }
+
+        if (ctrl[target] == kDeleted)
+            --deletedCount;
+        ctrl[target] = h2;
+        keys[target] = key;
+        values[target] = std::move(value);
+        ++elemCount;
+        return true;
+    }
+
+    bool find(const Key &key) const
+    {
+        const uint64_t h = mix(key);
+        return probe(key, h, static_cast<int8_t>(h & 0x7F), nullptr) != kNotFound;
+    }
+
+    // 查找 key 对应的附加信息，不存在返回 nullptr
+    Value *get(const Key &key)
+    {
+        const uint64_t h = mix(key);
+        size_t i = probe(key, h, static_cast<int8_t>(h & 0x7F), nullptr);
+        return i == kNotFound ? nullptr : &values[i];
+    }
+
+    const Value *get(const Key &key) const
+    {
+        const uint64_t h = mix(key);
+        size_t i = probe(key, h, static_cast<int8_t>(h & 0x7F), nullptr);
+        return i == kNotFound ? nullptr : &values[i];
+    }
+
+    bool erase(const Key &key)
+    {
+        const uint64_t h = mix(key);
+        size_t i = probe(key, h, static_cast<int8_t>(h & 0x7F), nullptr);
+        if (i == kNotFound)
+            return false;
+
+        // 本组仍有 EMPTY：没有任何探测会越过本组，可直接置为 EMPTY
+        size_t groupStart = i & ~(kGroupWidth - 1);
+        if (matchEmpty(&ctrl[groupStart]) != 0)
+        {
+            ctrl[i] = kEmpty;
+        }
+        else
+        {
+            ctrl[i] = kDeleted;
+            ++deletedCount;
+        }
+        values[i] = Value(); // 及时释放附加信息占用的资源
+        --elemCount;
+        return true;
+    }
+
+    void debugPrint() const
+    {
+        std::cout << "分组探测哈希表（size = " << keys.size()
+                  << ", 装载因子 ≈ " << loadFactor()
+                  << ", 墓碑数 = " << deletedCount << "）\n";
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            std::cout << i << ": ";
+            if (ctrl[i] == kEmpty)
+                std::cout << "EMPTY";
+            else if (ctrl[i] == kDeleted)
+                std::cout << "DELETED";
+            else
+            {
+                std::cout << keys[i];
+                if constexpr (!std::is_same<Value, NoValue>::value)
+                    std::cout << " => " << values[i];
+                std::cout << " (H2 = " << static_cast<int>(ctrl[i]) << ")";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+private:
+    static constexpr size_t kGroupWidth = 16;
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+    static constexpr int8_t kEmpty = -128;
+    static constexpr int8_t kDeleted = -2;
+
+    std::vector<int8_t> ctrl;  // 控制字节
+    std::vector<Key> keys;     // 关键字，与 ctrl 下标一一对应
+    std::vector<Value> values; // 附加信息，与 keys 分开存放，探测时不会读到
+    size_t elemCount;
+    size_t deletedCount;
+    Hash hasher;
+    KeyEqual keyEqual;
+
+    static size_t roundUpCapacity(size_t n)
+    {
+        size_t cap = kGroupWidth;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    // 高位用来选组（H1），低 7 位存入控制字节（H2）；
+    // 再做一次乘法折叠，即使传入的是恒等哈希（如 std::hash<int>）也能打散
+    uint64_t mix(const Key &key) const
+    {
+        uint64_t x = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL;
+        return x ^ (x >> 32);
+    }
+
+    void initTable(size_t cap)
+    {
+        ctrl.assign(cap, kEmpty);
+        keys.assign(cap, Key());
+        values.clear();
+        values.resize(cap); // resize 而非 assign：Value 可以是只能移动的类型
+        elemCount = 0;
+        deletedCount = 0;
+    }
+
+    //---------------- 组内比较：返回 16 位掩码，第 i 位对应组内第 i 个槽 ----------------
+    static uint32_t matchByte(const int8_t *g, int8_t b)
+    {
+#if defined(HASH_GROUP_SSE2)
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(b))));
+#elif defined(HASH_GROUP_NEON)
+        uint8x16_t eq = vceqq_s8(vld1q_s8(g), vdupq_n_s8(b));
+        return neonMoveMask(eq);
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i)
+            mask |= static_cast<uint32_t>(g[i] == b) << i;
+        return mask;
+#endif
+    }
+
+    static uint32_t matchEmpty(const int8_t *g) { return matchByte(g, kEmpty); }
+
+    // EMPTY 与 DELETED 的最高位都是 1，而已占用槽最高位为 0
+    static uint32_t matchEmptyOrDeleted(const int8_t *g)
+    {
+#if defined(HASH_GROUP_SSE2)
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g));
+        return static_cast<uint32_t>(_mm_movemask_epi8(v));
+#elif defined(HASH_GROUP_NEON)
+        uint8x16_t neg = vcltq_s8(vld1q_s8(g), vdupq_n_s8(0));
+        return neonMoveMask(neg);
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i)
+            mask |= static_cast<uint32_t>(g[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+#if defined(HASH_GROUP_NEON)
+    // NEON 没有 movemask：每个字节与 1,2,4,...,128 相与后按 8 字节横向求和
+    static uint32_t neonMoveMask(uint8x16_t m)
+    {
+        static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                          1, 2, 4, 8, 16, 32, 64, 128};
+        uint8x16_t bits = vandq_u8(m, vld1q_u8(kBits));
+        return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+               (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+    }
+#endif
+
+    static int lowestBit(uint32_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#else
+        int i = 0;
+        while (!(mask & 1u))
+        {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    /**
+     * @brief 沿探测序列查找 key
+     * @param insertPos 若非空，记录探测途中第一个 EMPTY/DELETED 槽（用于插入）
+     * @return 找到则返回槽下标，否则返回 kNotFound
+     */
+    size_t probe(const Key &key, uint64_t h, int8_t h2, size_t *insertPos) const
+    {
+        const size_t groupMask = keys.size() / kGroupWidth - 1;
+        size_t g = static_cast<size_t>(h >> 7) & groupMask;
+        if (insertPos)
+            *insertPos = kNotFound;
+
+        for (size_t step = 1; step <= groupMask + 1; ++step)
+        {
+            const size_t base = g * kGroupWidth;
+            const int8_t *grp = &ctrl[base];
+
+            for (uint32_t m = matchByte(grp, h2); m != 0; m &= m - 1)
+            {
+                size_t i = base + lowestBit(m);
+                if (keyEqual(keys[i], key))
+                    return i;
+            }
+            if (insertPos && *insertPos == kNotFound)
+            {
+                uint32_t avail = matchEmptyOrDeleted(grp);
+                if (avail != 0)
+                    *insertPos = base + lowestBit(avail);
+            }
+            if (matchEmpty(grp) != 0)
+                return kNotFound; // 本组有 EMPTY，探测到此为止
+
+            g = (g + step) & groupMask; // 三角数探测
+        }
+        return kNotFound;
+    }
+
+    // 按新表长重新散列（newSize 等于原表长时即“清理墓碑”）
+    void rehash(size_t newSize)
+    {
+        std::vector<int8_t> oldCtrl;
+        std::vector<Key> oldKeys;
+        std::vector<Value> oldValues;
+        oldCtrl.swap(ctrl);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        initTable(roundUpCapacity(newSize));
+
+        for (size_t i = 0; i < oldKeys.size(); ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                const uint64_t h = mix(oldKeys[i]);
+                size_t target;
+                probe(oldKeys[i], h, static_cast<int8_t>(h & 0x7F), &target);
+                ctrl[target] = static_cast<int8_t>(h & 0x7F);
+                keys[target] = std::move(oldKeys[i]);
+                values[target] = std::move(oldValues[i]);
+                ++elemCount;
+            }
+        }
+    }
+};
+
+//-------------------------------------------------------------
+ // 五、演示 main
 //-------------------------------------------------------------
 
 int main()
@@ -337,12 +1099,12 @@ int main()
 
     //----------- 1. 展示不同哈希函数的输出（对应 8.4.2） -----------
     {
-        std::cout << "[1] 哈希函数示例（平方取中 / 除留余数 / 伪随机）\n";
+        std::cout << "[1] 哈希函数示例（平方取中 / 除留余数 / 伪随机 / 斐波那契 / wyhash）\n";
         int keys[] = {19, 1, 23, 14, 55, 68, 11, 82, 36};
         size_t n = sizeof(keys) / sizeof(keys[0]);
         size_t tableSize = 11;
 
-        std::cout << "表长 m = " << tableSize << "\n";
+        std::cout << "表长 m = " << tableSize << "（斐波那契散列要求 2 的幂，取 m = 16）\n";
         for (size_t i = 0; i < n; ++i)
         {
             int k = keys[i];
@@ -350,6 +1112,8 @@ int main()
                       << ", square-middle = " << hashSquareMiddle(k, tableSize)
                       << ", mod-prime = " << hashModPrime(k, tableSize)
                       << ", pseudo-rand = " << hashPseudoRandom(k, tableSize)
+                      << ", fibonacci = " << hashFibonacci(static_cast<uint64_t>(k), 16)
+                      << ", wyhash = " << hashWy64(static_cast<uint64_t>(k), tableSize)
                       << "\n";
         }
         std::cout << "\n";
@@ -362,7 +1126,7 @@ int main()
         int keys[] = {19, 1, 23, 14, 55, 68, 11, 82, 36};
         size_t n = sizeof(keys) / sizeof(keys[0]);
 
-        OpenAddressHashTable ht(11, OpenAddressHashTable::ProbeType::LINEAR);
+        OpenAddressHashTable<> ht(11, OpenAddressHashTable<>::ProbeType::LINEAR);
         for (size_t i = 0; i < n; ++i)
         {
             ht.insert(keys[i]);
@@ -387,7 +1151,7 @@ int main()
         int keys[] = {19, 1, 23, 14, 55, 68, 11, 82, 36};
         size_t n = sizeof(keys) / sizeof(keys[0]);
 
-        ChainedHashTable cht(7);
+        ChainedHashTable<> cht(7);
         for (size_t i = 0; i < n; ++i)
             cht.insert(keys[i]);
 
@@ -402,6 +1166,140 @@ int main()
                   << (cht.find(searchKey) ? "存在\n" : "不存在\n");
     }
 
+    //----------- 4. 分组探测哈希表示例（Swiss Table 风格） -----------
+    {
+        std::cout << "\n[4] 分组探测哈希表示例（控制字节 + 16 槽一组比较）\n";
+        int keys[] = {19, 1, 23, 14, 55, 68, 11, 82, 36};
+        size_t n = sizeof(keys) / sizeof(keys[0]);
+
+        SwissHashTable<> sht(16);
+        for (size_t i = 0; i < n; ++i)
+            sht.insert(keys[i]);
+        sht.erase(14);
+
+        sht.debugPrint();
+
+        int searchKey = 55;
+        std::cout << "查找 " << searchKey << "："
+                  << (sht.find(searchKey) ? "存在\n" : "不存在\n");
+        searchKey = 14;
+        std::cout << "删除后查找 " << searchKey << "："
+                  << (sht.find(searchKey) ? "存在\n" : "不存在\n");
+
+        // 简单计时：与 OpenAddressHashTable 做同样的插入与查找（一半命中、一半不命中）
+        const int N = 200000;
+        std::mt19937 rng(7);
+        std::vector<int> data(N);
+        for (int &x : data)
+            x = static_cast<int>(rng() & 0x7FFFFFFF);
+
+        OpenAddressHashTable<> oa(11);
+        SwissHashTable<> sw;
+        for (int x : data)
+        {
+            oa.insert(x);
+            sw.insert(x);
+        }
+
+        auto timeFind = [&](auto &table) {
+            auto t0 = std::chrono::steady_clock::now();
+            size_t hit = 0;
+            for (int i = 0; i < N; ++i)
+                hit += table.find(data[i]) + table.find(data[i] ^ 0x40000000);
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << "    命中 " << hit << " 次，用时 "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+        };
+        std::cout << "  " << 2 * N << " 次查找：\n";
+        std::cout << "  OpenAddressHashTable（装载因子 " << oa.loadFactor() << "）\n";
+        timeFind(oa);
+        std::cout << "  SwissHashTable（装载因子 " << sw.loadFactor() << "）\n";
+        timeFind(sw);
+    }
+
+    //----------- 5. 泛型关键字 / 附加信息 / 可插拔哈希 -----------
+    {
+        std::cout << "\n[5] 64 位 ID -> 记录偏移 / 名称（模板参数 Key、Value、Hash）\n";
+        const uint64_t ids[] = {9000000000001ULL, 9000000000002ULL, 42ULL, 1ULL << 40, 7777777777ULL};
+
+        OpenAddressHashTable<uint64_t, uint64_t, FibonacciHash> offsetByIdOA(7);
+        ChainedHashTable<uint64_t, uint64_t, WyHash> offsetByIdCH(5);
+        SwissHashTable<uint64_t, std::string> nameById;
+        uint64_t offset = 0;
+        for (uint64_t id : ids)
+        {
+            offsetByIdOA.insert(id, offset);
+            offsetByIdCH.insert(id, offset);
+            nameById.insert(id, "record#" + std::to_string(offset / 128)); // 字符串被移动进表中
+            offset += 128;
+        }
+        offsetByIdOA.debugPrint();
+        offsetByIdCH.debugPrint();
+
+        for (uint64_t id : {42ULL, 1ULL << 40, 123ULL})
+        {
+            const uint64_t *off = offsetByIdOA.get(id);
+            const std::string *name = nameById.get(id);
+            std::cout << "ID " << id << "：";
+            if (off)
+                std::cout << "偏移 = " << *off << "（链地址表 = " << *offsetByIdCH.get(id)
+                          << "），名称 = " << *name << "\n";
+            else
+                std::cout << "不存在\n";
+        }
+    }
+
+    //----------- 6. 结点池链地址哈希表 + 链长直方图 -----------
+    {
+        std::cout << "\n[6] 结点池链地址哈希表（slab 分配、下标链接）\n";
+        int keys[] = {19, 1, 23, 14, 55, 68, 11, 82, 36};
+        PooledChainedHashTable<> pht(7);
+        for (int k : keys)
+            pht.insert(k);
+        pht.erase(68);
+        pht.insert(100); // 复用 68 释放的结点
+        pht.debugPrint();
+
+        std::cout << "链长直方图：\n";
+        printChainHistogram(pht.chainLengthHistogram());
+
+        // 插入/删除反复进行（churn）：std::list 版本 vs 结点池版本
+        const int N = 200000;
+        std::mt19937 rng(11);
+        std::vector<int> data(N);
+        for (int &x : data)
+            x = static_cast<int>(rng() & 0x7FFFFFFF);
+
+        auto churn = [&](auto &table, const char *name) {
+            auto t0 = std::chrono::steady_clock::now();
+            for (int round = 0; round < 4; ++round)
+            {
+                for (int x : data)
+                    table.insert(x + round);
+                for (int x : data)
+                    table.erase(x + round);
+            }
+            for (int x : data)
+                table.insert(x);
+            size_t hit = 0;
+            for (int x : data)
+                hit += table.find(x);
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << "  " << name << "：命中 " << hit << "，用时 "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+        };
+        ChainedHashTable<int, NoValue, WyHash> listTable(65537);
+        PooledChainedHashTable<int, NoValue, WyHash> poolTable(65537);
+        churn(listTable, "std::list 桶");
+        churn(poolTable, "结点池桶  ");
+
+        std::cout << "结点池版本（装载因子 " << poolTable.loadFactor() << "）链长直方图：\n";
+        printChainHistogram(poolTable.chainLengthHistogram());
+        poolTable.rehash(262147);
+        std::cout << "rehash 到 262147 个桶后（装载因子 " << poolTable.loadFactor() << "）：\n";
+        printChainHistogram(poolTable.chainLengthHistogram());
+    }
+
     std::cout << "\n提示：\n"
               << "  - 哈希表查找的平均时间复杂度期望为 O(1)，对应课件第 63–65 页。\n"
               << "  - 良好的哈希函数 + 合理的装载因子 + 适当的冲突处理策略，是高效哈希表的关键。\n"
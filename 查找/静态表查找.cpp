@@ -8,6 +8,7 @@
 //   1. 顺序查找（无序/有序静态表通用）
 //   2. 折半查找（基础版 mid = (low + high) / 2，对应第 16 页）
 //   3. 折半查找（溢出安全版 mid = low + ((high - low) >> 1)，对应第 18 页）
+//   4. Eytzinger（BFS）布局的只读查找表：预取 + 批量交错查找，掩盖内存延迟
 //
 // 为便于实验与理解，本文件使用简单的 int 数组作为“静态查找表”，
 // 并在 main 函数中给出示例。
@@ -20,6 +21,9 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <random>
+#include <chrono>
+#include <algorithm>
 
 //---------------------------------------------------------------------
 // 1. 顺序查找（对应课件第 8.2.1 节，第 9–12 页）
@@ -173,7 +177,206 @@ int BinarySearchSafe(const ElemType elem[], int n, const KeyType &key)
 }
 
 //---------------------------------------------------------------------
-// 4. 打印辅助函数与演示 main
+// 4. Eytzinger（BFS）布局的静态查找表 + 预取 + 批量查找
+//---------------------------------------------------------------------
+// 折半查找在普通有序数组上的问题：前几次比较的位置（n/2、n/4、3n/4 ...）
+// 彼此相距很远，表一大，几乎每一次比较都是一次缓存未命中，
+// 且下一次访问的位置依赖本次比较结果，CPU 只能干等内存。
+//
+// 静态查找表“装载后只读”，因此可以花 O(n) 时间把它重新排列：
+//   - Eytzinger 布局：把有序数组当作一棵完全二叉查找树，按层序（BFS）存入 b[1..n]，
+//     结点 k 的左右孩子为 2k、2k+1。查找时 k = 2k + (b[k] < key)，
+//     前几层集中在数组开头，总能留在缓存中；
+//   - 预取：结点 k 往下第 4 层的 16 个后代 b[16k .. 16k+15] 在内存中连续，
+//     正好一两个缓存行，提前 4 步预取，访存延迟与比较就重叠起来了；
+//   - 批量查找 searchMany：并排推进若干个互不相关的查找，
+//     多个缓存未命中同时在途，进一步掩盖内存延迟。
+//
+// 查找结果仍返回“在原有序数组中的下标”，与 BinarySearchBasic/Safe 一致。
+
+/**
+ * @brief Eytzinger 布局的静态查找表
+ *
+ * 构建：对 b[] 做一次中序遍历，依次填入有序数组中的元素，O(n)。
+ * 查找：无分支地下降到叶子之下，再去掉末尾连续的 1（右转）得到 lower_bound 的位置。
+ */
+template <class ElemType>
+class EytzingerTable
+{
+public:
+    EytzingerTable(const ElemType elem[], int n)
+        : n(n), b(static_cast<size_t>(n) + 1), rank(static_cast<size_t>(n) + 1, -1)
+    {
+        // 迭代式中序遍历 1..n（完全二叉树高度为 O(log n)，栈很小）
+        int src = 0;
+        std::vector<int> stack;
+        int k = 1;
+        while (k <= n || !stack.empty())
+        {
+            while (k <= n)
+            {
+                stack.push_back(k);
+                k = 2 * k;
+            }
+            k = stack.back();
+            stack.pop_back();
+            b[k] = elem[src];
+            rank[k] = src++;
+            k = 2 * k + 1;
+        }
+        levels = 0;
+        while ((1LL << levels) <= n)
+            ++levels; // 树高 floor(log2 n) + 1
+    }
+
+    int size() const { return n; }
+
+    /**
+     * @brief 查找 key
+     * @return 查找成功返回其在原有序数组中的下标，失败返回 -1
+     */
+    template <class KeyType>
+    int search(const KeyType &key) const
+    {
+        size_t k = 1;
+        while (k <= static_cast<size_t>(n))
+        {
+            prefetch(k * kPrefetchStride);
+            k = 2 * k + (b[k] < key);
+        }
+        k = climbToLowerBound(k);
+        return (k != 0 && !(key < b[k])) ? rank[k] : -1;
+    }
+
+    /**
+     * @brief 批量查找：results[i] 为 keys[i] 的查找结果（规则同 search）
+     *
+     * 每次并排推进 kBatch 个查找，所有查找都恰好下降 levels 层；
+     * 已越过叶子的查找用条件传送保持不动，因此内层循环没有分支。
+     */
+    template <class KeyType>
+    void searchMany(const KeyType keys[], int count, int results[]) const
+    {
+        int i = 0;
+        for (; i + kBatch <= count; i += kBatch)
+        {
+            size_t k[kBatch];
+            for (int j = 0; j < kBatch; ++j)
+                k[j] = 1;
+            for (int level = 0; level < levels; ++level)
+            {
+                for (int j = 0; j < kBatch; ++j)
+                {
+                    size_t cur = k[j] <= static_cast<size_t>(n) ? k[j] : static_cast<size_t>(n);
+                    size_t next = 2 * k[j] + (b[cur] < keys[i + j]);
+                    k[j] = k[j] <= static_cast<size_t>(n) ? next : k[j];
+                    prefetch(k[j] * kPrefetchStride);
+                }
+            }
+            for (int j = 0; j < kBatch; ++j)
+            {
+                size_t r = climbToLowerBound(k[j]);
+                results[i + j] = (r != 0 && !(keys[i + j] < b[r])) ? rank[r] : -1;
+            }
+        }
+        for (; i < count; ++i)
+            results[i] = search(keys[i]);
+    }
+
+private:
+    static constexpr int kBatch = 16;
+    // 4 层之后的后代在内存中连续，个数为 16；元素越大，需要预取的字节数越多
+    static constexpr size_t kPrefetchStride = 16;
+
+    int n;
+    int levels;
+    std::vector<ElemType> b; // b[1..n] 为 Eytzinger 布局，b[0] 不用
+    std::vector<int> rank;   // rank[k] 为 b[k] 在原有序数组中的下标
+
+    void prefetch(size_t k) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        if (k < b.size())
+            __builtin_prefetch(&b[k]);
+#else
+        (void)k;
+#endif
+    }
+
+    // 下降结束时 k 的二进制末尾有若干个 1（表示一路右转），
+    // 去掉这些 1 以及再上一位，就回到了“最后一次左转”的结点，即 lower_bound；
+    // 全部右转（key 大于所有元素）时得到 0。
+    static size_t climbToLowerBound(size_t k)
+    {
+        while (k & 1)
+            k >>= 1;
+        return k >> 1;
+    }
+};
+
+//---------------------------------------------------------------------
+// 5. 查找基准：顺序查找 / 折半查找 / Eytzinger / 批量 Eytzinger
+//---------------------------------------------------------------------
+
+/**
+ * @brief 在 n 个有序整数上比较各查找方法，输出每次查找的平均耗时
+ */
+void benchmarkStaticSearch(int n, int queries)
+{
+    std::vector<int> sorted(n);
+    for (int i = 0; i < n; ++i)
+        sorted[i] = 3 * i + 1;
+
+    std::mt19937 rng(42);
+    std::vector<int> keys(queries);
+    for (int &k : keys)
+        k = static_cast<int>(rng() % (3ULL * n + 3)); // 约 1/3 的查找成功
+
+    auto measure = [&](const char *name, int q, auto &&run) {
+        std::vector<int> out(q);
+        auto t0 = std::chrono::steady_clock::now();
+        run(out);
+        auto t1 = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (int r : out)
+            sum += r;
+        std::cout << "  " << std::left << std::setw(22) << name << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1)
+                  << std::chrono::duration<double, std::nano>(t1 - t0).count() / q
+                  << " ns/次   校验和 = " << sum << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    };
+
+    std::cout << "表长 n = " << n << "，查找 " << queries << " 次（顺序查找只做前 200 次）：\n";
+    measure("SeqSearch", std::min(queries, 200), [&](std::vector<int> &out) {
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = SeqSearch(sorted.data(), n, keys[i]);
+    });
+    measure("BinarySearchSafe(前200次)", std::min(queries, 200), [&](std::vector<int> &out) {
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = BinarySearchSafe(sorted.data(), n, keys[i]);
+    });
+    measure("BinarySearchBasic", queries, [&](std::vector<int> &out) {
+        for (int i = 0; i < queries; ++i)
+            out[i] = BinarySearchBasic(sorted.data(), n, keys[i]);
+    });
+    measure("BinarySearchSafe", queries, [&](std::vector<int> &out) {
+        for (int i = 0; i < queries; ++i)
+            out[i] = BinarySearchSafe(sorted.data(), n, keys[i]);
+    });
+
+    EytzingerTable<int> table(sorted.data(), n);
+    measure("Eytzinger::search", queries, [&](std::vector<int> &out) {
+        for (int i = 0; i < queries; ++i)
+            out[i] = table.search(keys[i]);
+    });
+    measure("Eytzinger::searchMany", queries, [&](std::vector<int> &out) {
+        table.searchMany(keys.data(), queries, out.data());
+    });
+}
+
+//---------------------------------------------------------------------
+// 6. 打印辅助函数与演示 main
 //---------------------------------------------------------------------
 
 template <typename T>
@@ -231,10 +434,32 @@ int main()
     else
         std::cout << "未找到\n";
 
+    // 示例 3：Eytzinger 布局（同一张有序表）
+    EytzingerTable<int> eyt(orderedElem, n2);
+    int posEyt = eyt.search(key2);
+    std::cout << "[Eytzinger 布局] 结果：";
+    if (posEyt != -1)
+        std::cout << "找到，位置下标 = " << posEyt << "\n";
+    else
+        std::cout << "未找到\n";
+
+    int batchKeys[] = {5, 6, 64, 92, 100, 21, 0, 88};
+    int batchRes[8];
+    eyt.searchMany(batchKeys, 8, batchRes);
+    std::cout << "[Eytzinger 批量查找] ";
+    for (int i = 0; i < 8; ++i)
+        std::cout << batchKeys[i] << "->" << batchRes[i] << " ";
+    std::cout << "\n";
+
+    // 示例 4：大表上的性能对比（表远大于缓存时差距才明显）
+    std::cout << "\n";
+    benchmarkStaticSearch(1 << 22, 1 << 20);
+
     std::cout << "\n提示：\n"
               << "  - 顺序查找适用于小规模或无序的数据集合；\n"
               << "  - 折半查找要求数据有序且以顺序表存储，平均查找长度为 O(log n)，\n"
-              << "    对应课件第 12、16、18、20 页关于折半查找和局限性的分析。\n";
+              << "    对应课件第 12、16、18、20 页关于折半查找和局限性的分析；\n"
+              << "  - 只读的大表可改用 Eytzinger 布局：访存更集中、可预取，批量查找还能重叠多次缓存未命中。\n";
 
     return 0;
 }
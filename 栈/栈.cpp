@@ -8,6 +8,8 @@
  *   - 链式栈：概念与实现片段：P22–P29（栈顶在链头；Push/Pop/Top/Traverse 等）。
  *   - 应用1：括号匹配（例3.2）：P30–P31。
  *   - 应用2：中缀表达式求值（两个栈 + Isp/Icp 优先级表）：P60–P64，优先级表见 P62。
+ *   - 扩展：SmallStack（内联小缓冲区的顺序栈）；RpnProgram（沿用 Isp/Icp 算法把中缀式
+ *     一次编译成后缀式指令序列，之后带变量反复求值、批量求值都不再解析与分配内存）。
  * 说明：在不改变教材语义的前提下做工程化补充（如顺序栈可选自动扩容），并在注释中标注出处页码。
  * 教材来源：四川大学计算机学院 孙奕髦《Chapter 3：Stack & Queue》— “栈 Stack”部分。
  */
@@ -20,6 +22,10 @@
 #include <cctype>
 #include <limits>
 #include <utility>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
 
 namespace ds {
 
@@ -234,6 +240,146 @@ private:
     bool full() const { return _ltop + 1 == _rtop; } // 两顶指针相邻即满（见 P20 示意）
 };
 
+// ============================== 小缓冲区顺序栈（扩展） ==============================
+// 前 N 个元素直接存放在对象内部的数组里（随对象位于调用者的栈帧中），不发生堆分配；
+// 超过 N 个才像 ArrayStack 一样 2 倍扩容到堆上。适合“通常很浅、偶尔很深”的临时栈，
+// 例如下文 RpnProgram 求值时的操作数栈。只构造 [0,count) 的元素，支持只移动类型。
+template <typename T, int N = 16>
+class SmallStack {
+    static_assert(N > 0, "内联容量 N 必须为正");
+public:
+    SmallStack() = default;
+    ~SmallStack() { Clear(); release(); }
+
+    SmallStack(const SmallStack& other) {
+        reserve(other._count);
+        for (int i = 0; i < other._count; ++i) Push(other._data[i]);
+    }
+
+    SmallStack& operator=(const SmallStack& other) {
+        if (this != &other) {
+            SmallStack tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    // 移动：堆上的存储直接接管；内联存储只能逐个移动元素
+    SmallStack(SmallStack&& other) noexcept { take(other); }
+
+    SmallStack& operator=(SmallStack&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    int Length() const { return _count; }                 // P7 (1)
+    bool Empty() const { return _count == 0; }            // P7 (2)
+    void Clear() {                                        // P7 (3)
+        for (int i = 0; i < _count; ++i) _data[i].~T();
+        _count = 0;
+    }
+    int Capacity() const { return _cap; }
+    bool IsInline() const { return _data == inline_data(); }
+
+    // 遍历：从栈底到栈顶（P8 (4)）
+    void Traverse(const std::function<void(const T&)>& visit) const {
+        for (int i = 0; i < _count; ++i) visit(_data[i]);
+    }
+
+    template <typename... Args>
+    T& Emplace(Args&&... args) {
+        if (_count == _cap) grow();
+        T* p = ::new (static_cast<void*>(_data + _count)) T(std::forward<Args>(args)...);
+        ++_count;
+        return *p;
+    }
+
+    // 入栈（P8 (5)）：无“栈满”，总是成功
+    bool Push(const T& e) {
+        if (_count == _cap) {
+            T copy(e);                      // e 可能就是栈内元素，扩容前先复制
+            Emplace(std::move(copy));
+        } else {
+            Emplace(e);
+        }
+        return true;
+    }
+    bool Push(T&& e) { Emplace(std::move(e)); return true; }
+
+    // 取栈顶（P9 (6)）；TopRef 直接访问，供只移动类型或原位修改
+    bool Top(T& e) const {
+        if (Empty()) return false;
+        e = _data[_count - 1];
+        return true;
+    }
+    T& TopRef() { return _data[_count - 1]; }
+    const T& TopRef() const { return _data[_count - 1]; }
+
+    // 出栈（P10 (7) / P11 (8)）
+    bool Pop(T& e) {
+        if (Empty()) return false;
+        e = std::move(_data[_count - 1]);
+        _data[--_count].~T();
+        return true;
+    }
+    bool Pop() {
+        if (Empty()) return false;
+        _data[--_count].~T();
+        return true;
+    }
+
+private:
+    alignas(T) unsigned char _inline[sizeof(T) * N];
+    T* _data = inline_data();
+    int _count = 0;
+    int _cap = N;
+
+    T* inline_data() { return std::launder(reinterpret_cast<T*>(_inline)); }
+    const T* inline_data() const { return std::launder(reinterpret_cast<const T*>(_inline)); }
+
+    void reserve(int cap) {
+        if (cap <= _cap) return;
+        T* nd = std::allocator<T>().allocate(static_cast<std::size_t>(cap));
+        for (int i = 0; i < _count; ++i) {
+            ::new (static_cast<void*>(nd + i)) T(std::move_if_noexcept(_data[i]));
+            _data[i].~T();
+        }
+        release();
+        _data = nd;
+        _cap = cap;
+    }
+
+    void grow() { reserve(_cap * 2); }                    // 与 ArrayStack::grow 相同的 2 倍策略
+
+    void release() {
+        if (!IsInline()) std::allocator<T>().deallocate(_data, static_cast<std::size_t>(_cap));
+        _data = inline_data();
+        _cap = N;
+    }
+
+    // 前提：*this 为空且使用内联存储
+    void take(SmallStack& other) noexcept {
+        if (other.IsInline()) {
+            for (int i = 0; i < other._count; ++i) {
+                ::new (static_cast<void*>(_data + i)) T(std::move(other._data[i]));
+                other._data[i].~T();
+            }
+            _count = other._count;
+        } else {
+            _data = other._data;
+            _cap = other._cap;
+            _count = other._count;
+            other._data = other.inline_data();
+            other._cap = N;
+        }
+        other._count = 0;
+    }
+};
+
 // ============================== 应用 1：括号匹配（例 3.2） ==============================
 // 依据 P30–P31 的构思：遇左括号入栈，遇右括号检查类型并弹出。
 inline bool is_left_bracket(char c)  { return c=='(' || c=='[' || c=='{'; }
@@ -408,6 +554,270 @@ bool eval_infix(const std::string& expr, long long& out, std::string& err) {
     return true;
 }
 
+// ============================== 应用 2 扩展：编译一次、反复求值 ==============================
+// eval_infix 每次调用都要重新扫描字符串、查 Isp/Icp 表。同一条规则式要对成千上万组变量
+// 求值时，先用 compile_infix 把它编译成后缀式（RPN）指令序列：
+//   - 仍是 P60–P64 的双栈算法，只是“计算一次 (a1)θ(a2)”改为“输出一条 θ 指令”，
+//     操作数栈也只记录深度（编译期即可算出求值所需的最大栈深 maxDepth）；
+//   - 支持变量：标识符 [A-Za-z_][A-Za-z0-9_]* 按首次出现顺序编号，求值时按编号传值；
+//   - 两个操作数都是常量的运算在编译期直接折叠（除零保留到运行期报错）。
+// Run 用内联 SmallStack 做操作数栈（maxDepth ≤ 64 时零分配），RunBatch 按列输入、
+// 每 64 行一组逐条指令整列执行，把指令分派的开销摊到整组上。
+class RpnProgram {
+public:
+    enum class OpCode : unsigned char { PushConst, PushVar, Add, Sub, Mul, Div, Mod };
+    struct Instr {
+        OpCode op;
+        long long arg;      // PushConst：常量值；PushVar：变量编号；其余不用
+    };
+
+    static constexpr int kInlineDepth = 64;   // Run 的内联栈深
+    static constexpr int kBatchRows   = 64;   // RunBatch 每组行数
+
+    int VariableCount() const { return static_cast<int>(_vars.size()); }
+    const std::string& VariableName(int index) const { return _vars[index]; }
+    // 按名字查编号，不存在返回 -1
+    int VariableIndex(const std::string& name) const {
+        for (int i = 0; i < VariableCount(); ++i) if (_vars[i] == name) return i;
+        return -1;
+    }
+    int MaxDepth() const { return _maxDepth; }
+    const std::vector<Instr>& Code() const { return _code; }
+
+    // 单次求值：vars[k] 为第 k 个变量的值；除以零返回 false
+    bool Run(const long long* vars, long long& out) const {
+        SmallStack<long long, kInlineDepth> st;
+        for (const Instr& in : _code) {
+            switch (in.op) {
+                case OpCode::PushConst: st.Emplace(in.arg); break;
+                case OpCode::PushVar:   st.Emplace(vars[in.arg]); break;
+                default: {
+                    long long a2 = st.TopRef();
+                    st.Pop();
+                    long long& a1 = st.TopRef();
+                    if (!apply(in.op, a1, a2)) return false;
+                }
+            }
+        }
+        out = st.TopRef();
+        return true;
+    }
+
+    // 批量求值：columns[k][r] 为第 r 行第 k 个变量的值，结果写入 out[r]。
+    // ok 非空时 ok[r] 标记该行是否成功（失败行 out[r] 置 0）；返回失败行数。
+    std::size_t RunBatch(const long long* const* columns, std::size_t rows,
+                         long long* out, bool* ok = nullptr) const {
+        std::size_t failed = 0;
+        if (_maxDepth > kBatchDepth) {                    // 栈太深：退回逐行求值
+            std::vector<long long> row(_vars.size());
+            for (std::size_t r = 0; r < rows; ++r) {
+                for (std::size_t k = 0; k < row.size(); ++k) row[k] = columns[k][r];
+                bool good = Run(row.data(), out[r]);
+                if (!good) { out[r] = 0; ++failed; }
+                if (ok) ok[r] = good;
+            }
+            return failed;
+        }
+        long long reg[kBatchDepth][kBatchRows];           // 每个栈槽位一整列
+        bool bad[kBatchRows];
+        for (std::size_t base = 0; base < rows; base += kBatchRows) {
+            int m = static_cast<int>(std::min<std::size_t>(kBatchRows, rows - base));
+            for (int j = 0; j < m; ++j) bad[j] = false;
+            int sp = 0;
+            for (const Instr& in : _code) {
+                switch (in.op) {
+                    case OpCode::PushConst:
+                        for (int j = 0; j < m; ++j) reg[sp][j] = in.arg;
+                        ++sp;
+                        break;
+                    case OpCode::PushVar: {
+                        const long long* col = columns[in.arg] + base;
+                        for (int j = 0; j < m; ++j) reg[sp][j] = col[j];
+                        ++sp;
+                        break;
+                    }
+                    case OpCode::Add: --sp; for (int j = 0; j < m; ++j) reg[sp - 1][j] += reg[sp][j]; break;
+                    case OpCode::Sub: --sp; for (int j = 0; j < m; ++j) reg[sp - 1][j] -= reg[sp][j]; break;
+                    case OpCode::Mul: --sp; for (int j = 0; j < m; ++j) reg[sp - 1][j] *= reg[sp][j]; break;
+                    default:                                 // Div / Mod：逐行检查除数
+                        --sp;
+                        for (int j = 0; j < m; ++j) {
+                            if (bad[j] || !apply(in.op, reg[sp - 1][j], reg[sp][j])) {
+                                bad[j] = true;
+                                reg[sp - 1][j] = 0;
+                            }
+                        }
+                }
+            }
+            for (int j = 0; j < m; ++j) {
+                out[base + j] = bad[j] ? 0 : reg[0][j];
+                if (bad[j]) ++failed;
+                if (ok) ok[base + j] = !bad[j];
+            }
+        }
+        return failed;
+    }
+
+private:
+    static constexpr int kBatchDepth = 16;             // RunBatch 分组执行支持的最大栈深
+
+    std::vector<Instr> _code;
+    std::vector<std::string> _vars;
+    int _maxDepth = 0;
+
+    // a1 = (a1) θ (a2)；除以零返回 false（同 apply_op）
+    static bool apply(OpCode op, long long& a1, long long a2) {
+        switch (op) {
+            case OpCode::Add: a1 += a2; return true;
+            case OpCode::Sub: a1 -= a2; return true;
+            case OpCode::Mul: a1 *= a2; return true;
+            case OpCode::Div: if (a2 == 0) return false; a1 /= a2; return true;
+            case OpCode::Mod: if (a2 == 0) return false; a1 %= a2; return true;
+            default: return false;
+        }
+    }
+
+    static OpCode opcode_of(char theta) {
+        switch (theta) {
+            case '+': return OpCode::Add;
+            case '-': return OpCode::Sub;
+            case '*': return OpCode::Mul;
+            case '/': return OpCode::Div;
+            default : return OpCode::Mod;
+        }
+    }
+
+    // 输出一条二元运算指令；两个操作数恰为最后两条常量指令时就地折叠
+    void emit_binary(char theta) {
+        OpCode op = opcode_of(theta);
+        std::size_t n = _code.size();
+        if (n >= 2 && _code[n - 1].op == OpCode::PushConst && _code[n - 2].op == OpCode::PushConst) {
+            long long a1 = _code[n - 2].arg;
+            if (apply(op, a1, _code[n - 1].arg)) {
+                _code.pop_back();
+                _code.back().arg = a1;
+                return;
+            }
+        }
+        _code.push_back({op, 0});
+    }
+
+    friend bool compile_infix(const std::string& expr, RpnProgram& prog, std::string& err);
+};
+
+// 编译：与 eval_infix 相同的 Isp/Icp 双栈流程（P60–P64），opnd 栈只记深度
+bool compile_infix(const std::string& expr, RpnProgram& prog, std::string& err) {
+    prog = RpnProgram();
+    ArrayStack<char> optr(32, true);
+    optr.Push('=');                                   // P60 step 1
+    std::string s = expr;
+    s.push_back('=');                                 // 末尾补 '='（P60）
+    int depth = 0;
+
+    auto read_operand = [&](size_t& i) -> bool {
+        if (std::isdigit(static_cast<unsigned char>(s[i]))) {
+            long long val = 0;
+            while (i < s.size() && std::isdigit(static_cast<unsigned char>(s[i]))) {
+                int d = s[i] - '0';
+                if (val > (std::numeric_limits<long long>::max() - d) / 10) { err = "数字过大"; return false; }
+                val = val * 10 + d;
+                ++i;
+            }
+            prog._code.push_back({RpnProgram::OpCode::PushConst, val});
+        } else if (std::isalpha(static_cast<unsigned char>(s[i])) || s[i] == '_') {
+            size_t b = i;
+            while (i < s.size() && (std::isalnum(static_cast<unsigned char>(s[i])) || s[i] == '_')) ++i;
+            std::string name = s.substr(b, i - b);
+            int idx = prog.VariableIndex(name);
+            if (idx < 0) {
+                idx = prog.VariableCount();
+                prog._vars.push_back(name);
+            }
+            prog._code.push_back({RpnProgram::OpCode::PushVar, idx});
+        } else {
+            err = "语法错误：期望数字或变量名";
+            return false;
+        }
+        prog._maxDepth = std::max(prog._maxDepth, ++depth);
+        return true;
+    };
+
+    size_t i = 0;
+    char ch = 0, top = 0;
+    while (true) {
+        while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
+        ch = i < s.size() ? s[i] : '=';
+
+        if (!is_op(ch)) {                             // P61：操作数
+            if (!read_operand(i)) return false;
+            continue;
+        }
+        optr.Top(top);
+        if (top == '=' && ch == '=') break;
+
+        int in_stack = Isp(top), in_coming = Icp(ch);
+        if (in_stack < in_coming) {
+            optr.Push(ch);
+            ++i;
+        } else if (in_stack > in_coming) {
+            char theta = 0;
+            optr.Pop(theta);
+            // 括号只会在配对时对消；被当作运算符弹出说明 '(' 缺 ')' 或 ')' 缺 '('
+            if (theta == '(' || theta == ')') { err = "括号不匹配"; return false; }
+            if (depth < 2) { err = "语法错误：操作数不足"; return false; }
+            --depth;                                  // 退 a2、a1，结果入栈：净减 1
+            prog.emit_binary(theta);
+        } else if (ch == ')') {
+            optr.Pop();                               // 对消括号（P61/P64）
+            ++i;
+        } else {
+            err = "语法错误（括号不匹配或优先级相等的非法组合）";
+            return false;
+        }
+    }
+    if (depth != 1) { err = "语法错误：表达式不完整"; return false; }
+    return true;
+}
+
+// 与逐次 eval_infix 的耗时对比：表达式 (x + 3) * y - x % 7 + y / 2，rows 组不同的 x、y
+inline void benchmark_compiled_eval(int rows) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<long long> xs(rows), ys(rows);
+    std::vector<std::string> texts(rows);
+    for (int r = 0; r < rows; ++r) {
+        xs[r] = (r * 37) % 1000 + 1;
+        ys[r] = (r * 91) % 500 + 1;
+        texts[r] = "(" + std::to_string(xs[r]) + " + 3) * " + std::to_string(ys[r]) + " - " +
+                   std::to_string(xs[r]) + " % 7 + " + std::to_string(ys[r]) + " / 2";
+    }
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    std::vector<long long> r1(rows), r2(rows), r3(rows);
+    std::string err;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rows; ++r) eval_infix(texts[r], r1[r], err);
+    auto t1 = Clock::now();
+
+    RpnProgram prog;
+    compile_infix("(x + 3) * y - x % 7 + y / 2", prog, err);
+    long long vars[2];
+    for (int r = 0; r < rows; ++r) {
+        vars[0] = xs[r]; vars[1] = ys[r];
+        prog.Run(vars, r2[r]);
+    }
+    auto t2 = Clock::now();
+
+    const long long* cols[2] = {xs.data(), ys.data()};
+    prog.RunBatch(cols, static_cast<std::size_t>(rows), r3.data());
+    auto t3 = Clock::now();
+
+    std::cout << "[Compiled] rows=" << rows << "  eval_infix " << ms(t0, t1)
+              << " ms, Run " << ms(t1, t2) << " ms (含一次编译), RunBatch " << ms(t2, t3) << " ms"
+              << ((r1 == r2 && r2 == r3) ? "" : "  (结果不一致!)") << "\n";
+}
+
 } // namespace ds
 
 // ============================== Demo & 自测 ==============================
@@ -448,6 +858,31 @@ int main() {
     bool ok = eval_infix("4 + 2 * 3 - 10 / 5", res, err);
     std::cout << "[Eval] 4 + 2 * 3 - 10 / 5 = " << (ok ? std::to_string(res) : ("ERROR: " + err)) << "\n";
 
+    // --- 小缓冲区栈：前 8 个元素不分配堆内存 ---
+    SmallStack<std::string, 8> ss;
+    for (int i = 0; i < 8; ++i) ss.Push("s" + std::to_string(i));
+    std::cout << "[SmallStack] 8 个元素 inline=" << (ss.IsInline() ? "true" : "false");
+    ss.Push("s8");
+    std::cout << "，第 9 个后 inline=" << (ss.IsInline() ? "true" : "false")
+              << " Capacity=" << ss.Capacity() << "\n";
+
+    // --- 编译一次、带变量反复求值 ---
+    RpnProgram prog;
+    if (compile_infix("rate * (qty + 2 * 3) - bonus % 7", prog, err)) {
+        std::cout << "[Compiled] 变量:";
+        for (int k = 0; k < prog.VariableCount(); ++k) std::cout << ' ' << prog.VariableName(k);
+        std::cout << "，指令数=" << prog.Code().size() << "（2 * 3 已折叠），最大栈深=" << prog.MaxDepth() << "\n";
+        long long v1[] = {5, 4, 20}, r1;
+        prog.Run(v1, r1);
+        std::cout << "[Compiled] rate=5 qty=4 bonus=20 -> " << r1 << "\n";
+        long long rate[] = {1, 2, 3}, qty[] = {0, 1, 2}, bonus[] = {7, 8, 9};
+        const long long* cols[] = {rate, qty, bonus};
+        long long outv[3];
+        prog.RunBatch(cols, 3, outv);
+        std::cout << "[Compiled] 批量 3 行 -> " << outv[0] << ' ' << outv[1] << ' ' << outv[2] << "\n";
+    }
+    benchmark_compiled_eval(200000);
+
     return 0;
 }
 
@@ -25,11 +25,19 @@
  *   —— 以及课件 6.3 拓展：
  *   - 非递归先/中/后序遍历 (NonRecurPreOrder / NonRecurInOrder / NonRecurPostOrder)
  *   - 由先序+中序构建二叉树 (CreateFromPreIn / CreateFromPreInSpan)
+ *   —— 扩展：
+ *   - 结点池 NodeArena：成批分配结点，整树销毁时一次归还（元素可平凡析构时 O(块数)）
+ *   - 复制/销毁/高度/计数/遍历全部非递归（沿 parent 指针行走，O(1) 额外空间），
+ *     退化成链的树也不会栈溢出；遍历接受任意可调用对象（函数对象可被内联）
+ *   - STL 风格的中序双向迭代器：for (const T& x : tree)
+ *   - CompleteBinaryTree：完全二叉树的隐式数组存储（课件 6.2 性质5 的编号规则）
  *
  * 设计说明：
  * 1) parent 指针：便于 O(1) 求双亲（与课件 6.2.3(b) 三叉链表一致）。
  * 2) LevelOrder 使用 std::queue；非递归遍历使用 std::stack。
  * 3) 全部接口为强异常安全：若 new 失败会抛出 std::bad_alloc；析构/删除保证释放完整子树。
+ * 4) 树内结点均由本树的 NodeArena 分配；BinaryTree(Node*) 接管外部 new 出的结点时，
+ *    先复制进结点池，再逐个 delete 原结点。
  *
  * 编译：g++ -std=c++17 -O2 -Wall -Wextra 二叉树.cpp -o btree_demo
  * 运行：./btree_demo
@@ -40,6 +48,12 @@
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 using namespace std;
 
 template <class T>
@@ -54,6 +68,69 @@ struct BinTreeNode {
         : data(v), left(l), right(r), parent(p) {}
 };
 
+// 结点池：按块批量申请内存（每块容量翻倍，至多 4096 个结点），单个释放的结点挂到空闲链上复用；
+// ReleaseAll() 直接归还所有块而不逐个析构，O(块数)——调用者须保证结点无需析构
+// 或已自行析构。非线程安全。
+template <class Node>
+class NodeArena {
+    union Slot {
+        Slot* nextFree;
+        alignas(Node) unsigned char raw[sizeof(Node)];
+    };
+    vector<unique_ptr<Slot[]>> chunks;
+    Slot* freeList = nullptr;
+    size_t bump = 0, chunkCap = 0;     // 最后一块中已切出的槽数 / 最后一块容量
+    size_t nextChunk = 16;
+
+public:
+    NodeArena() = default;
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+    NodeArena(NodeArena&& o) noexcept { swap(o); }
+    NodeArena& operator=(NodeArena&& o) noexcept {
+        if (this != &o) { NodeArena tmp(std::move(o)); swap(tmp); }
+        return *this;
+    }
+    void swap(NodeArena& o) noexcept {
+        chunks.swap(o.chunks);
+        std::swap(freeList, o.freeList);
+        std::swap(bump, o.bump);
+        std::swap(chunkCap, o.chunkCap);
+        std::swap(nextChunk, o.nextChunk);
+    }
+
+    template <class... Args>
+    Node* Create(Args&&... args) {
+        Slot* s;
+        if (freeList) { s = freeList; freeList = s->nextFree; }
+        else {
+            if (bump == chunkCap) {
+                chunks.emplace_back(new Slot[nextChunk]);
+                chunkCap = nextChunk; bump = 0;
+                if (nextChunk < 4096) nextChunk *= 2;
+            }
+            s = chunks.back().get() + bump++;
+        }
+        try { return ::new (static_cast<void*>(s)) Node(std::forward<Args>(args)...); }
+        catch (...) { s->nextFree = freeList; freeList = s; throw; }
+    }
+
+    void Destroy(Node* n) {
+        n->~Node();
+        Slot* s = reinterpret_cast<Slot*>(n);
+        s->nextFree = freeList;
+        freeList = s;
+    }
+
+    void ReleaseAll() noexcept {
+        chunks.clear();
+        freeList = nullptr;
+        bump = chunkCap = 0;
+        nextChunk = 16;
+    }
+    size_t ChunkCount() const { return chunks.size(); }
+};
+
 template <class T>
 class BinaryTree {
 public:
@@ -61,67 +138,107 @@ public:
 
 private:
     Node* root{nullptr};
+    NodeArena<Node> arena;        // 本树全部结点的来源
 
-    // --- 辅助：复制、销毁、遍历、统计、高度、查找双亲 ---
-    static Node* copyTree(Node* r, Node* parent=nullptr) {
-        if (!r) return nullptr;
-        Node* n = new Node(r->data);
-        n->parent = parent;
-        n->left  = copyTree(r->left,  n);
-        n->right = copyTree(r->right, n);
-        return n;
+    // --- 沿 parent 指针的非递归行走（O(1) 额外空间），均限定在以 top 为根的子树内 ---
+    static Node* leftmost(Node* p) { while (p->left) p = p->left; return p; }
+    static Node* rightmost(Node* p) { while (p->right) p = p->right; return p; }
+    // 后序第一个结点：一路向左，无左孩子则向右，直到叶子
+    static Node* postFirst(Node* p) {
+        for (;;) {
+            if (p->left) p = p->left;
+            else if (p->right) p = p->right;
+            else return p;
+        }
     }
-
-    static void destroy(Node*& r) {
-        if (!r) return;
-        destroy(r->left);
-        destroy(r->right);
-        delete r;
-        r = nullptr;
+    static Node* inNext(Node* p, const Node* top) {
+        if (p->right) return leftmost(p->right);
+        while (p != top && p->parent->right == p) p = p->parent;   // 从右子树回溯
+        return p == top ? nullptr : p->parent;
+    }
+    static Node* inPrev(Node* p, const Node* top) {
+        if (p->left) return rightmost(p->left);
+        while (p != top && p->parent->left == p) p = p->parent;
+        return p == top ? nullptr : p->parent;
+    }
+    static Node* postNext(Node* p, const Node* top) {
+        if (p == top) return nullptr;
+        Node* q = p->parent;
+        if (q->left == p && q->right) return postFirst(q->right);
+        return q;
     }
 
-    static void preOrder(Node* r, void (*visit)(const T&)) {
-        if (!r) return;
-        visit(r->data);
-        preOrder(r->left, visit);
-        preOrder(r->right, visit);
+    // --- 辅助：复制、销毁（非递归） ---
+    // 复制：显式栈保存 (源结点, 新结点) 对。根先写入 out、新结点一建好就挂到树上，
+    // 因此元素复制中途抛出异常时，已建部分始终是以 out 为根的完整子树，可由 clear() 析构
+    void copyTree(const Node* src, Node*& out) {
+        out = nullptr;
+        if (!src) return;
+        out = arena.Create(src->data);
+        vector<pair<const Node*, Node*>> st{{src, out}};
+        while (!st.empty()) {
+            auto [s, d] = st.back(); st.pop_back();
+            if (s->right) { d->right = arena.Create(s->right->data); d->right->parent = d; st.push_back({s->right, d->right}); }
+            if (s->left)  { d->left  = arena.Create(s->left->data);  d->left->parent  = d; st.push_back({s->left,  d->left}); }
+        }
     }
-    static void inOrder(Node* r, void (*visit)(const T&)) {
-        if (!r) return;
-        inOrder(r->left, visit);
-        visit(r->data);
-        inOrder(r->right, visit);
+
+    // 逐个 delete 外部 new 出的结点（显式栈，非递归）
+    static void deleteRaw(Node* r) {
+        vector<Node*> st;
+        if (r) st.push_back(r);
+        while (!st.empty()) {
+            Node* p = st.back(); st.pop_back();
+            if (p->left) st.push_back(p->left);
+            if (p->right) st.push_back(p->right);
+            delete p;
+        }
     }
-    static void postOrder(Node* r, void (*visit)(const T&)) {
+
+    // 销毁以 r 为根的子树：按后序逐个析构并送回结点池
+    void destroy(Node*& r) {
         if (!r) return;
-        postOrder(r->left, visit);
-        postOrder(r->right, visit);
-        visit(r->data);
+        Node* top = r;
+        for (Node* p = postFirst(top); p; ) {
+            Node* nx = postNext(p, top);
+            arena.Destroy(p);
+            p = nx;
+        }
+        r = nullptr;
     }
 
-    static int height(Node* r) {
-        if (!r) return 0;
-        return max(height(r->left), height(r->right)) + 1;
-    }
-    static int nodeCount(Node* r) {
-        if (!r) return 0;
-        return nodeCount(r->left) + nodeCount(r->right) + 1;
+    // 整树销毁：元素可平凡析构时直接归还全部内存块，O(块数)
+    void clear() {
+        if (is_trivially_destructible<T>::value) { root = nullptr; arena.ReleaseAll(); }
+        else { destroy(root); arena.ReleaseAll(); }
     }
 
 public:
     // --- 构造/析构/拷贝 ---
     BinaryTree() = default;
-    explicit BinaryTree(const T& e) { root = new Node(e); }
-    explicit BinaryTree(Node* r) : root(r) {}
-    BinaryTree(const BinaryTree& other) { root = copyTree(other.root); }
+    explicit BinaryTree(const T& e) { root = arena.Create(e); }
+    // 接管外部 new 出的结点（如 CreateFromPreInSpan 的结果）：复制进结点池后逐个 delete 原结点
+    // 复制失败时已接管的原结点也一并释放，不泄漏
+    explicit BinaryTree(Node* r) {
+        try { copyTree(r, root); } catch (...) { clear(); deleteRaw(r); throw; }
+        deleteRaw(r);
+    }
+    BinaryTree(const BinaryTree& other) {
+        try { copyTree(other.root, root); } catch (...) { clear(); throw; }
+    }
+    BinaryTree(BinaryTree&& other) noexcept : root(other.root), arena(std::move(other.arena)) { other.root = nullptr; }
     BinaryTree& operator=(const BinaryTree& other) {
         if (this == &other) return *this;
-        Node* newRoot = copyTree(other.root);
-        destroy(root);
-        root = newRoot;
+        BinaryTree tmp(other);          // 先复制，成功后再交换（强异常安全）
+        swap(tmp);
         return *this;
     }
-    ~BinaryTree() { destroy(root); }
+    BinaryTree& operator=(BinaryTree&& other) noexcept {
+        if (this != &other) { BinaryTree tmp(std::move(other)); swap(tmp); }
+        return *this;
+    }
+    void swap(BinaryTree& other) noexcept { std::swap(root, other.root); arena.swap(other.arena); }
+    ~BinaryTree() { clear(); }
 
     // (1) 根
     const Node* GetRoot() const { return root; }
@@ -143,13 +260,35 @@ public:
         return true;
     }
 
-    // (5)(6)(7) 递归遍历
-    void PreOrder(void (*visit)(const T&)) const { preOrder(root, visit); }
-    void InOrder (void (*visit)(const T&)) const { inOrder (root, visit); }
-    void PostOrder(void (*visit)(const T&)) const{ postOrder(root, visit); }
+    // (5)(6)(7) 先/中/后序遍历：次序与课件递归定义相同，实现改为沿 parent 指针行走，
+    // 不用递归也不用栈。visit 可以是函数指针或任意函数对象（后者可被内联）。
+    template <class Visit>
+    void PreOrder(Visit visit) const {
+        Node* p = root;
+        while (p) {
+            visit(static_cast<const T&>(p->data));
+            if (p->left) p = p->left;
+            else if (p->right) p = p->right;
+            else {                                    // 叶子：回溯到第一个“从左子树返回且有右子树”的祖先
+                while (p != root && !(p->parent->left == p && p->parent->right)) p = p->parent;
+                p = (p == root) ? nullptr : p->parent->right;
+            }
+        }
+    }
+    template <class Visit>
+    void InOrder(Visit visit) const {
+        if (!root) return;
+        for (Node* p = leftmost(root); p; p = inNext(p, root)) visit(static_cast<const T&>(p->data));
+    }
+    template <class Visit>
+    void PostOrder(Visit visit) const {
+        if (!root) return;
+        for (Node* p = postFirst(root); p; p = postNext(p, root)) visit(static_cast<const T&>(p->data));
+    }
 
     // (8) 层次遍历
-    void LevelOrder(void (*visit)(const T&)) const {
+    template <class Visit>
+    void LevelOrder(Visit visit) const {
         if (!root) return;
         queue<Node*> q;
         q.push(root);
@@ -162,7 +301,11 @@ public:
     }
 
     // (9) 结点计数
-    int NodeCount() const { return nodeCount(root); }
+    int NodeCount() const {
+        int n = 0;
+        PreOrder([&n](const T&) { ++n; });
+        return n;
+    }
 
     // (10)(11)(12) 左/右孩子、双亲
     Node* LeftChild (const Node* cur) const { return cur ? cur->left  : nullptr; }
@@ -172,7 +315,7 @@ public:
     // (13) 插入左孩子：若已有左子树，则成为新结点的左子树（与课件一致）
     void InsertLeftChild(Node* cur, const T& e) {
         if (!cur) throw invalid_argument("InsertLeftChild: cur is null");
-        Node* n = new Node(e);
+        Node* n = arena.Create(e);
         n->left = cur->left;
         if (n->left) n->left->parent = n;
         n->right = nullptr;
@@ -182,7 +325,7 @@ public:
     // (14) 插入右孩子：若已有右子树，则成为新结点的右子树
     void InsertRightChild(Node* cur, const T& e) {
         if (!cur) throw invalid_argument("InsertRightChild: cur is null");
-        Node* n = new Node(e);
+        Node* n = arena.Create(e);
         n->right = cur->right;
         if (n->right) n->right->parent = n;
         n->left = nullptr;
@@ -200,11 +343,53 @@ public:
         destroy(cur->right);
     }
 
-    // (17) 高度
-    int Height() const { return height(root); }
+    // (17) 高度：先序行走，下行时深度 +1、回溯时按爬升的层数减
+    int Height() const {
+        int h = 0, d = 0;
+        Node* p = root;
+        while (p) {
+            h = max(h, ++d);
+            if (p->left) p = p->left;
+            else if (p->right) p = p->right;
+            else {
+                while (p != root && !(p->parent->left == p && p->parent->right)) { p = p->parent; --d; }
+                p = (p == root) ? nullptr : p->parent->right;  // 转到兄弟，与当前结点同层
+                --d;
+            }
+        }
+        return h;
+    }
+
+    // ------------------ 中序双向迭代器 ------------------
+    // 沿 parent 指针求后继/前驱，单步均摊 O(1)；end() 的 -- 回到中序最后一个结点
+    class const_iterator {
+        const BinaryTree* tree{nullptr};
+        Node* p{nullptr};
+        friend class BinaryTree;
+        const_iterator(const BinaryTree* t, Node* n) : tree(t), p(n) {}
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        const_iterator() = default;
+        reference operator*() const { return p->data; }
+        pointer operator->() const { return &p->data; }
+        const_iterator& operator++() { p = inNext(p, tree->root); return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++*this; return t; }
+        const_iterator& operator--() { p = p ? inPrev(p, tree->root) : rightmost(tree->root); return *this; }
+        const_iterator operator--(int) { const_iterator t = *this; --*this; return t; }
+        const Node* node() const { return p; }
+        bool operator==(const const_iterator& o) const { return p == o.p; }
+        bool operator!=(const const_iterator& o) const { return p != o.p; }
+    };
+    const_iterator begin() const { return const_iterator(this, root ? leftmost(root) : nullptr); }
+    const_iterator end() const { return const_iterator(this, nullptr); }
 
     // ------------------ 6.3 非递归遍历 ------------------
-    void NonRecurPreOrder(void (*visit)(const T&)) const {
+    template <class Visit>
+    void NonRecurPreOrder(Visit visit) const {
         if (!root) return;
         stack<Node*> st;
         st.push(root);
@@ -217,7 +402,8 @@ public:
         }
     }
 
-    void NonRecurInOrder(void (*visit)(const T&)) const {
+    template <class Visit>
+    void NonRecurInOrder(Visit visit) const {
         stack<Node*> st;
         Node* cur = root;
         while (cur || !st.empty()) {
@@ -232,7 +418,8 @@ public:
     }
 
     // 采用“标记法”后序：second=true 表示已访问过右子树/即可输出
-    void NonRecurPostOrder(void (*visit)(const T&)) const {
+    template <class Visit>
+    void NonRecurPostOrder(Visit visit) const {
         stack<pair<Node*, bool>> st;
         Node* cur = root;
         while (cur || !st.empty()) {
@@ -268,10 +455,105 @@ public:
         return r;
     }
 
+    // 非递归 O(n) 版本（要求元素互不相同，同递归版靠“值相等”定位根）：
+    // 按先序依次建结点，栈中保存“尚未确定右孩子”的祖先链；
+    // 栈顶不等于中序当前元素时新结点是栈顶的左孩子，否则弹出与中序相等的结点，
+    // 新结点是最后弹出者的右孩子。建好后再核对一遍先序/中序，不一致则抛出异常。
     static BinaryTree CreateFromPreIn(const vector<T>& pre, const vector<T>& in) {
         if (pre.size() != in.size()) throw invalid_argument("长度不一致");
-        Node* r = CreateFromPreInSpan(pre, 0, (int)pre.size()-1, in, 0, (int)in.size()-1, nullptr);
-        return BinaryTree(r);
+        BinaryTree t;
+        if (pre.empty()) return t;
+        t.root = t.arena.Create(pre[0]);
+        vector<Node*> st{t.root};
+        size_t j = 0;
+        for (size_t i = 1; i < pre.size(); ++i) {
+            Node* n = t.arena.Create(pre[i]);
+            Node* top = st.back();
+            if (!(top->data == in[j])) {
+                top->left = n;
+            } else {
+                while (!st.empty() && j < in.size() && st.back()->data == in[j]) { top = st.back(); st.pop_back(); ++j; }
+                top->right = n;
+            }
+            n->parent = top;
+            st.push_back(n);
+        }
+        size_t k = 0;
+        bool ok = true;
+        t.PreOrder([&](const T& x) { ok = ok && x == pre[k++]; });
+        k = 0;
+        t.InOrder([&](const T& x) { ok = ok && x == in[k++]; });
+        if (!ok) throw runtime_error("序列不匹配：先序/中序不一致");
+        return t;
+    }
+};
+
+// ------------------ 完全二叉树的隐式数组存储 ------------------
+// 课件 6.2 性质5：按层序从 1 开始编号，结点 i 的双亲为 i/2，左右孩子为 2i、2i+1。
+// 完全二叉树用一个 vector 顺序存放即可，不需要任何指针：结点只占元素本身的空间，
+// 同层结点相邻，层次遍历就是顺序扫描。对外编号 1..n，0 表示“无此结点”。
+template <class T>
+class CompleteBinaryTree {
+    vector<T> elems;                      // elems[i-1] 为编号 i 的结点
+public:
+    CompleteBinaryTree() = default;
+    explicit CompleteBinaryTree(vector<T> levelOrder) : elems(std::move(levelOrder)) {}
+    // 由链式二叉树转换：按层序收集，遇到第一个空位之后不得再有结点，否则不是完全二叉树
+    explicit CompleteBinaryTree(const BinaryTree<T>& bt) {
+        using Node = typename BinaryTree<T>::Node;
+        vector<const Node*> q;
+        if (bt.GetRoot()) q.push_back(bt.GetRoot());
+        bool gap = false;
+        for (size_t i = 0; i < q.size(); ++i) {
+            for (const Node* c : {static_cast<const Node*>(q[i]->left), static_cast<const Node*>(q[i]->right)}) {
+                if (!c) { gap = true; continue; }
+                if (gap) throw invalid_argument("CompleteBinaryTree: 不是完全二叉树");
+                q.push_back(c);
+            }
+        }
+        elems.reserve(q.size());
+        for (const Node* n : q) elems.push_back(n->data);
+    }
+
+    int Size() const { return static_cast<int>(elems.size()); }
+    bool Empty() const { return elems.empty(); }
+    // 高度 = ⌊log2 n⌋ + 1（课件 6.2 性质4）
+    int Height() const { int h = 0; for (size_t n = elems.size(); n; n >>= 1) ++h; return h; }
+    int Parent(int i) const { return i > 1 ? i / 2 : 0; }
+    int LeftChild(int i) const { return 2 * i <= Size() ? 2 * i : 0; }
+    int RightChild(int i) const { return 2 * i + 1 <= Size() ? 2 * i + 1 : 0; }
+    T& operator[](int i) { return elems[i - 1]; }
+    const T& operator[](int i) const { return elems[i - 1]; }
+
+    template <class Visit>
+    void LevelOrder(Visit visit) const { for (const T& x : elems) visit(x); }
+
+    // 中序：只靠编号运算求后继，无栈。右子树存在则进入其最左；
+    // 否则沿“自己是右孩子（奇数）”一路上溯，再上一层即后继
+    template <class Visit>
+    void InOrder(Visit visit) const {
+        const int n = Size();
+        if (n == 0) return;
+        int i = 1;
+        while (2 * i <= n) i *= 2;
+        while (i) {
+            visit(elems[i - 1]);
+            if (2 * i + 1 <= n) { i = 2 * i + 1; while (2 * i <= n) i *= 2; }
+            else { while (i > 1 && (i & 1)) i /= 2; i /= 2; }
+        }
+    }
+
+    // 先序：有左孩子则下行；否则上溯到第一个“是左孩子且有右兄弟”的结点，转到兄弟
+    template <class Visit>
+    void PreOrder(Visit visit) const {
+        const int n = Size();
+        int i = n ? 1 : 0;
+        while (i) {
+            visit(elems[i - 1]);
+            if (2 * i <= n) { i = 2 * i; continue; }
+            while (i > 1 && ((i & 1) || i + 1 > n)) i /= 2;
+            i = (i > 1) ? i + 1 : 0;
+        }
     }
 };
 
@@ -283,13 +565,36 @@ int main(){
     vector<char> in  = {'c','b','d','a','e','g','f'};
     auto bt = BinaryTree<char>::CreateFromPreIn(pre, in);
 
-    cout<<"递归先序："; bt.PreOrder(print_char); cout<<"\n";
-    cout<<"递归中序："; bt.InOrder(print_char);  cout<<"\n";
-    cout<<"递归后序："; bt.PostOrder(print_char);cout<<"\n";
+    cout<<"先序："; bt.PreOrder(print_char); cout<<"\n";
+    cout<<"中序："; bt.InOrder(print_char);  cout<<"\n";
+    cout<<"后序："; bt.PostOrder(print_char);cout<<"\n";
     cout<<"层次遍历："; bt.LevelOrder(print_char);cout<<"\n";
     cout<<"非递归先序："; bt.NonRecurPreOrder(print_char); cout<<"\n";
     cout<<"非递归中序："; bt.NonRecurInOrder(print_char);  cout<<"\n";
     cout<<"非递归后序："; bt.NonRecurPostOrder(print_char);cout<<"\n";
     cout<<"节点数："<<bt.NodeCount()<<", 高度："<<bt.Height()<<"\n";
+    cout<<"中序迭代器："; for (char c : bt) cout<<c<<' ';
+    cout<<"\n逆中序：";
+    for (auto it = bt.end(); it != bt.begin(); ) { --it; cout<<*it<<' '; }
+    cout<<"\n";
+
+    // 完全二叉树：层序 a..j 顺序存放
+    CompleteBinaryTree<char> cbt(vector<char>{'a','b','c','d','e','f','g','h','i','j'});
+    cout<<"完全二叉树 先序："; cbt.PreOrder(print_char);
+    cout<<"\n完全二叉树 中序："; cbt.InOrder(print_char);
+    cout<<"\n高度："<<cbt.Height()<<"，结点 5 的孩子："<<cbt[cbt.LeftChild(5)]<<"，双亲："<<cbt[cbt.Parent(5)]<<"\n";
+
+    // 退化成链的深树：递归实现会栈溢出，这里全部非递归；结点由结点池成批分配
+    const int depth = 1000000;
+    auto t0 = chrono::steady_clock::now();
+    BinaryTree<int> chain(0);
+    for (int i = 1; i < depth; ++i) chain.InsertLeftChild(chain.GetRoot(), i);   // 新结点插在根与原左子树之间
+    BinaryTree<int> chainCopy(chain);
+    long long sum = 0;
+    chainCopy.InOrder([&sum](int x) { sum += x; });             // lambda 可被内联
+    int h = chainCopy.Height();
+    auto t1 = chrono::steady_clock::now();
+    cout<<"深度 "<<depth<<" 的链：高度 "<<h<<"，中序和 "<<sum<<"，建树+复制+遍历 "
+        <<chrono::duration<double, milli>(t1 - t0).count()<<" ms\n";
     return 0;
 }
\ No newline at end of file
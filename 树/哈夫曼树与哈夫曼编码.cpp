@@ -14,8 +14,13 @@
 //   2) 为每个字符生成前缀编码（Encode(char)）
 //   3) 把比特串译回原字符序列（Decode(bits)）
 //   4) 计算并展示 WPL，与样例中的“总编码长度 = WPL”相印证（p.148）
+//   5) 工程化扩展：规范哈夫曼编码 CanonicalHuffmanCode（含码长上限）、
+//      64 位位流 BitWriter/BitReader、11 位一级表 + 二级表的查表译码 HuffmanTableDecoder，
+//      以及整段压缩/解压 HuffmanCompress / HuffmanDecompress
+//   6) 分块流式压缩容器：HuffmanStreamCompress / HuffmanStreamDecompress（多块并行编码/译码），
+//      HuffmanContainerReader（按块索引随机访问）
 //
-// 编译：g++ -std=c++17 -O2 -Wall -Wextra 哈夫曼树与哈夫曼编码.cpp -o huffman_demo
+// 编译：g++ -std=c++17 -O2 -Wall -Wextra -pthread 哈夫曼树与哈夫曼编码.cpp -o huffman_demo
 // 运行：./huffman_demo
 //
 #include <iostream>
@@ -27,6 +32,12 @@
 #include <utility>
 #include <queue>
 #include <functional>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <exception>
 using namespace std;
 
 /** ===================== 一、理论对照小抄 =====================
@@ -233,7 +244,887 @@ private:
     }
 };
 
-/** ===================== 三、演示（与课件示例一致） =====================
+/** ===================== 三、规范哈夫曼编码、位流与查表译码 =====================
+ * 上面的 HuffmanTree 忠实对应课件的构造与编码/译码过程，但用于真正压缩数据时有三处瓶颈：
+ *   • EncodeString 输出 '0'/'1' 字符，每个比特占 1 字节，体积是真实编码的 8 倍；
+ *   • Encode 每个字符一次 unordered_map 查找；
+ *   • Decode 每读 1 比特沿 left/right 走一步，分支多、访存跳跃。
+ * 工程上的做法：
+ *   1) 规范哈夫曼编码（canonical Huffman）：哈夫曼树只用来确定每个符号的“码长”；
+ *      码字按“码长升序、同长按符号升序”依次分配连续整数：
+ *          code = 0；对每个码长 L = 1..maxLen：同长码字从 code 起连续编号，然后 code = (code + count[L]) << 1。
+ *      这样得到的仍是前缀码、WPL 不变（码长未变），而解码方只需知道每个符号的码长就能重建全部码字，
+ *      压缩文件里只存 256 个码长即可，不必存整棵树。
+ *   2) 码长上限：为使查表译码的表大小可控，码长限制在 kHuffMaxCodeLen = 15 以内。
+ *      极端偏斜的频度可能产生更长的码，此时把超长的码截到上限后，
+ *      按 Kraft 不等式 ∑2^(-L_i) <= 1 调整：不断把某个较短码“加长 1 位”腾出码空间，直到等式成立，
+ *      再按频度从低到高把长码分给低频符号（代价是 WPL 略增，只在极端分布下发生）。
+ *   3) 位流：BitWriter 把码字按“高位在前”拼进 64 位累加器，满 64 位整字写出；
+ *      BitReader 一次装入 8 字节，保证缓冲区里至少有 56 个有效比特，取码只是移位与掩码。
+ *   4) 查表译码：一次窥视(peek) kHuffPrimaryBits = 11 位作为下标查一级表，
+ *      表项直接给出“符号 + 码长”，消耗码长位即可，不再逐比特走树；
+ *      码长超过 11 位的少数长码，一级表项指向二级表，再窥视剩余位查一次。
+ *      一级表 2048 项 × 4 字节 = 8 KiB，常驻 L1 缓存。
+ * ======================================================================= */
+
+const int kHuffSymbols = 256;
+const int kHuffMaxCodeLen = 15;
+const int kHuffPrimaryBits = 11;
+
+// 规范哈夫曼码表：length[s] == 0 表示符号 s 不出现
+struct CanonicalHuffmanCode
+{
+    uint8_t length[kHuffSymbols] = {};
+    uint32_t code[kHuffSymbols] = {};
+    int maxLength = 0;
+
+    // 由 256 个符号的频度求码长（两最小权合并 + 码长上限调整），再分配规范码字
+    static CanonicalHuffmanCode FromFrequencies(const uint64_t freq[kHuffSymbols], int maxLen = kHuffMaxCodeLen)
+    {
+        if (maxLen < 8 || maxLen > kHuffMaxCodeLen)
+            throw invalid_argument("码长上限需在 [8, 15] 之间");
+        CanonicalHuffmanCode c;
+        vector<int> symbols;
+        for (int s = 0; s < kHuffSymbols; ++s)
+            if (freq[s] > 0)
+                symbols.push_back(s);
+        if (symbols.empty())
+            return c;
+        if (symbols.size() == 1)
+        { // 只有一种符号：约定码长 1（与 HuffmanTree 中 n=1 时编码为 "0" 一致）
+            c.length[symbols[0]] = 1;
+            c.assignCodes();
+            return c;
+        }
+
+        // (1) 两最小权合并（同 p.137 的构造算法，用小顶堆代替线性 Select），记录双亲求叶深度
+        int n = (int)symbols.size();
+        vector<uint64_t> weight(2 * n - 1);
+        vector<int> parent(2 * n - 1, -1);
+        using Item = pair<uint64_t, int>;
+        priority_queue<Item, vector<Item>, greater<Item>> pq;
+        for (int i = 0; i < n; ++i)
+        {
+            weight[i] = freq[symbols[i]];
+            pq.push({weight[i], i});
+        }
+        for (int k = n; k < 2 * n - 1; ++k)
+        {
+            int a = pq.top().second;
+            pq.pop();
+            int b = pq.top().second;
+            pq.pop();
+            weight[k] = weight[a] + weight[b];
+            parent[a] = parent[b] = k;
+            pq.push({weight[k], k});
+        }
+        // 内部结点编号大于其孩子，自根向下一遍即可求出深度
+        vector<int> depth(2 * n - 1, 0);
+        for (int k = 2 * n - 3; k >= 0; --k)
+            depth[k] = depth[parent[k]] + 1;
+
+        // (2) 码长上限调整：统计各码长的码字个数，超长的截到 maxLen，再按 Kraft 不等式修正
+        vector<int> count(maxLen + 1, 0);
+        for (int i = 0; i < n; ++i)
+            ++count[min(depth[i], maxLen)];
+        uint64_t kraft = 0; // ∑ 2^(maxLen - L)，合法前缀码要求 <= 2^maxLen
+        for (int L = 1; L <= maxLen; ++L)
+            kraft += (uint64_t)count[L] << (maxLen - L);
+        while (kraft > (1ull << maxLen))
+        {
+            // 取一个最长码（接上限）去掉，再把某个较短码加长 1 位、一分为二：净减少 1 个单位码空间
+            --count[maxLen];
+            for (int L = maxLen - 1; L >= 1; --L)
+            {
+                if (count[L] > 0)
+                {
+                    --count[L];
+                    count[L + 1] += 2;
+                    break;
+                }
+            }
+            --kraft;
+        }
+
+        // (3) 按频度从低到高分配码长：低频符号拿长码（同频按符号序，保证结果确定）
+        vector<int> order(symbols);
+        sort(order.begin(), order.end(), [&](int x, int y) {
+            return freq[x] != freq[y] ? freq[x] < freq[y] : x > y;
+        });
+        int idx = 0;
+        for (int L = maxLen; L >= 1; --L)
+            for (int k = 0; k < count[L]; ++k)
+                c.length[order[idx++]] = (uint8_t)L;
+        c.assignCodes();
+        return c;
+    }
+
+    // 只给出码长（例如从压缩文件头读出）时重建码字
+    static CanonicalHuffmanCode FromLengths(const uint8_t length[kHuffSymbols])
+    {
+        CanonicalHuffmanCode c;
+        for (int s = 0; s < kHuffSymbols; ++s)
+        {
+            if (length[s] > kHuffMaxCodeLen)
+                throw runtime_error("码长超过上限");
+            c.length[s] = length[s];
+        }
+        c.assignCodes();
+        return c;
+    }
+
+    // 直接沿用课件 HuffmanTree 各字符的码长（即 Codes() 中码字的长度）生成规范码
+    static CanonicalHuffmanCode FromTree(const HuffmanTree &tree)
+    {
+        uint8_t length[kHuffSymbols] = {};
+        for (const auto &kv : tree.Codes())
+        {
+            if (kv.second.size() > (size_t)kHuffMaxCodeLen)
+                throw invalid_argument("课件树的码长超过 15，请改用 FromFrequencies（带码长上限调整）");
+            length[(uint8_t)kv.first] = (uint8_t)kv.second.size();
+        }
+        return FromLengths(length);
+    }
+
+    // 码字的 0/1 串形式（仅用于打印）
+    string CodeString(int s) const
+    {
+        string bits;
+        for (int b = length[s] - 1; b >= 0; --b)
+            bits.push_back(((code[s] >> b) & 1) ? '1' : '0');
+        return bits;
+    }
+
+private:
+    // 规范码字分配：码长升序、同长按符号升序，连续编号
+    void assignCodes()
+    {
+        int count[kHuffMaxCodeLen + 1] = {};
+        maxLength = 0;
+        for (int s = 0; s < kHuffSymbols; ++s)
+        {
+            if (length[s])
+            {
+                ++count[length[s]];
+                maxLength = max(maxLength, (int)length[s]);
+            }
+        }
+        uint32_t next[kHuffMaxCodeLen + 2] = {};
+        uint32_t codeValue = 0;
+        for (int L = 1; L <= kHuffMaxCodeLen; ++L)
+        {
+            next[L] = codeValue;
+            codeValue = (codeValue + count[L]) << 1;
+        }
+        if (next[maxLength] + count[maxLength] > (1u << maxLength) && maxLength > 0)
+            throw runtime_error("码长不满足 Kraft 不等式，不是合法的前缀码");
+        for (int s = 0; s < kHuffSymbols; ++s)
+            if (length[s])
+                code[s] = next[length[s]]++;
+    }
+};
+
+// —— 位写入器：高位在前，攒满 64 位整字写出（大端字节序，与 BitReader 一致）
+class BitWriter
+{
+public:
+    explicit BitWriter(vector<uint8_t> &out) : out_(out) {}
+
+    // 写入 code 的低 len 位（1 <= len <= 32）
+    void Put(uint32_t code, int len)
+    {
+        if (used_ + len < 64)
+        {
+            acc_ = (acc_ << len) | code;
+            used_ += len;
+            return;
+        }
+        int spill = used_ + len - 64; // 放不下的低位个数
+        acc_ = (acc_ << (len - spill)) | (code >> spill);
+        writeWord(acc_);
+        acc_ = spill ? (code & ((1u << spill) - 1)) : 0;
+        used_ = spill;
+    }
+
+    // 写出剩余不足 64 位的部分（低位补 0 到整字节）；返回写出的总比特数
+    uint64_t Flush()
+    {
+        uint64_t total = bits_ + used_;
+        if (used_ > 0)
+        {
+            uint64_t v = acc_ << (64 - used_);
+            for (int b = 0; b < used_; b += 8)
+                out_.push_back((uint8_t)(v >> (56 - b)));
+        }
+        bits_ = total;
+        acc_ = 0;
+        used_ = 0;
+        return total;
+    }
+
+private:
+    void writeWord(uint64_t w)
+    {
+        uint8_t bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = (uint8_t)(w >> (56 - 8 * i));
+        out_.insert(out_.end(), bytes, bytes + 8);
+        bits_ += 64;
+    }
+
+    vector<uint8_t> &out_;
+    uint64_t acc_ = 0; // 低 used_ 位有效
+    int used_ = 0;
+    uint64_t bits_ = 0;
+};
+
+// —— 位读取器：buf_ 的高 avail_ 位为待读比特；读到末尾之后视为 0
+// 为了让译码内循环不做越界判断，允许读过末尾（avail_ 变为负数），由调用者最后用 Overrun() 检查。
+class BitReader
+{
+public:
+    BitReader(const uint8_t *data, size_t size) : p_(data), end_(data + size) { Refill(); }
+
+    // 保证 avail_ >= 56（数据不足时尽量多装）
+    void Refill()
+    {
+        if (end_ - p_ >= 8)
+        {
+            // 一次读 8 字节、取其中能装下的整字节数；多读的比特与下一次装入的比特相同，按位或不影响结果
+            uint64_t w = 0;
+            for (int i = 0; i < 8; ++i)
+                w = (w << 8) | p_[i];
+            buf_ |= w >> avail_;
+            int bytes = (63 - avail_) >> 3;
+            p_ += bytes;
+            avail_ += bytes * 8;
+            return;
+        }
+        while (avail_ <= 56 && p_ < end_)
+        {
+            buf_ |= (uint64_t)(*p_++) << (56 - avail_);
+            avail_ += 8;
+        }
+    }
+
+    uint32_t Peek(int k) const { return (uint32_t)(buf_ >> (64 - k)); }
+    void Consume(int k)
+    {
+        buf_ <<= k;
+        avail_ -= k;
+    }
+    int Available() const { return avail_; }
+    // 是否读过了数据末尾
+    bool Overrun() const { return avail_ < 0; }
+
+private:
+    const uint8_t *p_;
+    const uint8_t *end_;
+    uint64_t buf_ = 0;
+    int avail_ = 0;
+};
+
+// —— 查表译码器
+// 一级表项（32 位）：低 16 位为符号（或二级表起点），16..23 位为码长；码长为 0 表示“查二级表”，
+// 此时 24..31 位为二级表的下标位数 subBits。二级表项格式同一级表，码长为完整码长。
+class HuffmanTableDecoder
+{
+public:
+    explicit HuffmanTableDecoder(const CanonicalHuffmanCode &c)
+    {
+        primary_.assign(1u << kHuffPrimaryBits, 0);
+        // 短码：码字左对齐到 11 位后，所有以它为前缀的下标都指向该符号
+        for (int s = 0; s < kHuffSymbols; ++s)
+        {
+            int L = c.length[s];
+            if (L == 0 || L > kHuffPrimaryBits)
+                continue;
+            uint32_t first = c.code[s] << (kHuffPrimaryBits - L);
+            uint32_t span = 1u << (kHuffPrimaryBits - L);
+            for (uint32_t i = 0; i < span; ++i)
+                primary_[first + i] = (uint32_t)s | ((uint32_t)L << 16);
+        }
+        // 长码：按 11 位前缀分组，每组一张 2^(组内最长码长 - 11) 项的二级表
+        const uint32_t noTable = ~0u;
+        vector<int> groupBits(1u << kHuffPrimaryBits, 0);
+        for (int s = 0; s < kHuffSymbols; ++s)
+        {
+            int L = c.length[s];
+            if (L > kHuffPrimaryBits)
+            {
+                uint32_t prefix = c.code[s] >> (L - kHuffPrimaryBits);
+                groupBits[prefix] = max(groupBits[prefix], L - kHuffPrimaryBits);
+            }
+        }
+        vector<uint32_t> groupStart(1u << kHuffPrimaryBits, noTable);
+        for (uint32_t prefix = 0; prefix < groupBits.size(); ++prefix)
+        {
+            if (groupBits[prefix] == 0)
+                continue;
+            groupStart[prefix] = (uint32_t)secondary_.size();
+            primary_[prefix] = groupStart[prefix] | ((uint32_t)groupBits[prefix] << 24);
+            secondary_.resize(secondary_.size() + (1u << groupBits[prefix]), 0);
+        }
+        for (int s = 0; s < kHuffSymbols; ++s)
+        {
+            int L = c.length[s];
+            if (L <= kHuffPrimaryBits)
+                continue;
+            uint32_t prefix = c.code[s] >> (L - kHuffPrimaryBits);
+            int sub = groupBits[prefix];
+            uint32_t rest = c.code[s] & ((1u << (L - kHuffPrimaryBits)) - 1);
+            uint32_t first = rest << (sub - (L - kHuffPrimaryBits));
+            uint32_t span = 1u << (sub - (L - kHuffPrimaryBits));
+            for (uint32_t i = 0; i < span; ++i)
+                secondary_[groupStart[prefix] + first + i] = (uint32_t)s | ((uint32_t)L << 16);
+        }
+    }
+
+    // 从 in 中译出 count 个符号写入 out
+    // 每次 Refill 后缓冲区至少有 56 位，足够连续译 3 个码（3 × 15 = 45 位），
+    // 因此内循环每 3 个符号才补充一次比特，且不做越界判断，最后统一检查是否读过末尾。
+    void Decode(BitReader &in, uint8_t *out, size_t count) const
+    {
+        size_t i = 0;
+        for (; i + 3 <= count; i += 3)
+        {
+            in.Refill();
+            out[i] = decodeOne(in);
+            out[i + 1] = decodeOne(in);
+            out[i + 2] = decodeOne(in);
+        }
+        for (; i < count; ++i)
+        {
+            in.Refill();
+            out[i] = decodeOne(in);
+        }
+        if (in.Overrun())
+            throw runtime_error("比特流提前结束");
+    }
+
+private:
+    uint8_t decodeOne(BitReader &in) const
+    {
+        uint32_t e = primary_[in.Peek(kHuffPrimaryBits)];
+        uint32_t L = (e >> 16) & 0xff;
+        if (L == 0)
+        { // 长码：再窥视 subBits 位查二级表
+            uint32_t sub = e >> 24;
+            if (sub == 0)
+                throw runtime_error("比特流中出现未定义的码字");
+            uint32_t idx = in.Peek(kHuffPrimaryBits + sub) & ((1u << sub) - 1);
+            e = secondary_[(e & 0xffff) + idx];
+            L = (e >> 16) & 0xff;
+            if (L == 0)
+                throw runtime_error("比特流中出现未定义的码字");
+        }
+        in.Consume(L);
+        return (uint8_t)e;
+    }
+
+    vector<uint32_t> primary_;
+    vector<uint32_t> secondary_;
+};
+
+// 频度统计：4 张计数表交替累加，避免连续相同字节对同一计数器的读-改-写相互等待
+// （原理见“三（续）”）。表项用 uint32_t 以少占缓存，因此按 1 GiB 分段统计、
+// 每段结束把计数并入 64 位的 freq，任意长度的输入都不会回绕
+void CountFrequencies(const uint8_t *data, size_t size, uint64_t freq[kHuffSymbols])
+{
+    const size_t kSegment = size_t(1) << 30;   // 每张表每段至多计 2^28 次
+    for (int s = 0; s < kHuffSymbols; ++s)
+        freq[s] = 0;
+    for (size_t base = 0; base < size; base += kSegment)
+    {
+        const uint8_t *p = data + base;
+        size_t n = std::min(kSegment, size - base);
+        uint32_t t[4][kHuffSymbols] = {};
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            ++t[0][p[i]];
+            ++t[1][p[i + 1]];
+            ++t[2][p[i + 2]];
+            ++t[3][p[i + 3]];
+        }
+        for (; i < n; ++i)
+            ++t[0][p[i]];
+        for (int s = 0; s < kHuffSymbols; ++s)
+            freq[s] += (uint64_t)t[0][s] + t[1][s] + t[2][s] + t[3][s];
+    }
+}
+
+// —— 整段压缩/解压：128 字节码长表（每个符号 4 位）+ 8 字节原文长度（小端）+ 比特流
+vector<uint8_t> HuffmanCompress(const uint8_t *data, size_t size)
+{
+    uint64_t freq[kHuffSymbols];
+    CountFrequencies(data, size, freq);
+    CanonicalHuffmanCode c = CanonicalHuffmanCode::FromFrequencies(freq);
+
+    vector<uint8_t> out;
+    out.reserve(size / 2 + 160);
+    for (int s = 0; s < kHuffSymbols; s += 2)
+        out.push_back((uint8_t)(c.length[s] << 4 | c.length[s + 1]));
+    for (int b = 0; b < 8; ++b)
+        out.push_back((uint8_t)((uint64_t)size >> (8 * b)));
+
+    BitWriter writer(out);
+    for (size_t i = 0; i < size; ++i)
+        writer.Put(c.code[data[i]], c.length[data[i]]);
+    writer.Flush();
+    return out;
+}
+
+vector<uint8_t> HuffmanDecompress(const uint8_t *data, size_t size)
+{
+    const size_t header = kHuffSymbols / 2 + 8;
+    if (size < header)
+        throw runtime_error("压缩数据不完整");
+    uint8_t length[kHuffSymbols];
+    for (int s = 0; s < kHuffSymbols; s += 2)
+    {
+        length[s] = data[s / 2] >> 4;
+        length[s + 1] = data[s / 2] & 0x0f;
+    }
+    uint64_t count = 0;
+    for (int b = 0; b < 8; ++b)
+        count |= (uint64_t)data[kHuffSymbols / 2 + b] << (8 * b);
+    if (count / 8 > size - header) // 每个符号至少 1 位
+        throw runtime_error("压缩数据不完整");
+
+    vector<uint8_t> out(count);
+    if (count == 0)
+        return out;
+    HuffmanTableDecoder decoder(CanonicalHuffmanCode::FromLengths(length));
+    BitReader reader(data + header, size - header);
+    decoder.Decode(reader, out.data(), count);
+    return out;
+}
+
+// —— 对比课件版 EncodeString/Decode 与查表版的吞吐（构造类似日志的文本）
+void BenchmarkHuffman(size_t bytes)
+{
+    mt19937 rng(2024);
+    const char *words[] = {"INFO", "WARN", "ERROR", "GET", "POST", "/api/v1/items", "/login",
+                           "user=", "latency_ms=", "status=200", "status=404", "ok", "retry"};
+    string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes)
+    {
+        text += "2024-06-";
+        text += to_string(10 + rng() % 20);
+        text += ' ';
+        for (int k = 0; k < 4; ++k)
+        {
+            text += words[rng() % 13];
+            text += to_string(rng() % 1000);
+            text += ' ';
+        }
+        text += '\n';
+    }
+    text.resize(bytes);
+    const uint8_t *raw = (const uint8_t *)text.data();
+
+    auto t0 = chrono::steady_clock::now();
+    vector<uint8_t> packed = HuffmanCompress(raw, text.size());
+    auto t1 = chrono::steady_clock::now();
+    vector<uint8_t> back = HuffmanDecompress(packed.data(), packed.size());
+    auto t2 = chrono::steady_clock::now();
+    bool ok = back.size() == text.size() && equal(back.begin(), back.end(), raw);
+
+    auto mbps = [&](chrono::steady_clock::duration d, size_t n) {
+        return n / 1e6 / chrono::duration<double>(d).count();
+    };
+    cout << "  查表版: " << text.size() << " B -> " << packed.size() << " B（"
+         << 100.0 * packed.size() / text.size() << "%），编码 " << mbps(t1 - t0, text.size())
+         << " MB/s，译码 " << mbps(t2 - t1, text.size()) << " MB/s，" << (ok ? "校验通过" : "校验失败") << "\n";
+
+    // 课件版：只取前 1 MB，避免 01 字符串占用过多内存
+    string sample = text.substr(0, min<size_t>(text.size(), 1 << 20));
+    unordered_map<char, int> cnt;
+    for (char ch : sample)
+        ++cnt[ch];
+    vector<char> chars;
+    vector<int> weights;
+    for (auto &kv : cnt)
+    {
+        chars.push_back(kv.first);
+        weights.push_back(kv.second);
+    }
+    HuffmanTree ht(chars, weights);
+    auto t3 = chrono::steady_clock::now();
+    string bits = ht.EncodeString(sample);
+    auto t4 = chrono::steady_clock::now();
+    string decoded = ht.Decode(bits);
+    auto t5 = chrono::steady_clock::now();
+    cout << "  课件版: " << sample.size() << " B -> " << bits.size() << " 个 '0'/'1' 字符，编码 "
+         << mbps(t4 - t3, sample.size()) << " MB/s，译码 " << mbps(t5 - t4, sample.size()) << " MB/s，"
+         << (decoded == sample ? "校验通过" : "校验失败") << "\n";
+}
+
+/** ===================== 三（续）分块流式压缩容器 =====================
+ * 整段压缩要求全文在内存里、且只有一张码表。面对持续写入的大日志文件，改为“分块”处理：
+ *   • 输入按 blockSize（默认 1 MiB）切块，每块单独统计频度、单独生成规范码表——
+ *     日志内容随时间漂移时，每块的码表更贴合本块分布；
+ *   • 块与块之间互不依赖，一批 threads 个块同时在多个线程上编码/译码，
+ *     内存占用只与 threads × blockSize 有关，与文件大小无关；
+ *   • 每块自带块头（原长、载荷长、模式、码长表），可以顺序流式解压；
+ *     文件末尾另有块偏移索引，随机访问时可以直接跳到第 i 块解压。
+ *
+ * 容器格式（多字节整数均为小端）：
+ *   文件头   "HUFS"(4) | 版本 1(1) | 保留(3) | blockSize(4)
+ *   块 × N   rawSize(4) | payloadSize(4) | mode(1) | 保留(3) | [mode=1 时：128 字节码长表] | 载荷
+ *            mode = 0：载荷为原文（数据几乎不可压缩时，哈夫曼编码反而更长）
+ *            mode = 1：载荷为哈夫曼比特流
+ *   结束块   rawSize = 0 | payloadSize = 0 | mode = 0xFF | 保留(3)
+ *   索引     offset[0..N-1](各 8)：各块块头在文件中的偏移
+ *   尾部     N(8) | 索引起始偏移(8) | "HUFI"(4)
+ *
+ * 频度统计用 4 张计数表轮流累加：若只用一张表，连续相同的字节会对同一个计数器“读-改-写”，
+ * 后一次读必须等前一次写完成（store-to-load 转发），日志中的空格、连续数字都很常见；
+ * 4 张表把相邻字节分散到不同的计数器上，最后再合并。
+ * ======================================================================= */
+
+namespace huffstream
+{
+const char kFileMagic[4] = {'H', 'U', 'F', 'S'};
+const char kTailMagic[4] = {'H', 'U', 'F', 'I'};
+const uint8_t kModeStored = 0;
+const uint8_t kModeHuffman = 1;
+const uint8_t kModeEnd = 0xFF;
+const size_t kBlockHeaderSize = 12;
+
+inline void PutLE(vector<uint8_t> &out, uint64_t v, int bytes)
+{
+    for (int b = 0; b < bytes; ++b)
+        out.push_back((uint8_t)(v >> (8 * b)));
+}
+
+inline uint64_t GetLE(const uint8_t *p, int bytes)
+{
+    uint64_t v = 0;
+    for (int b = 0; b < bytes; ++b)
+        v |= (uint64_t)p[b] << (8 * b);
+    return v;
+}
+
+inline void WriteAll(ostream &out, const vector<uint8_t> &bytes)
+{
+    out.write((const char *)bytes.data(), (streamsize)bytes.size());
+    if (!out)
+        throw runtime_error("写出压缩数据失败");
+}
+
+// 读满 n 字节；返回实际读到的字节数（文件末尾时可能不足）
+inline size_t ReadUpTo(istream &in, uint8_t *buf, size_t n)
+{
+    in.read((char *)buf, (streamsize)n);
+    return (size_t)in.gcount();
+}
+
+// 把一块原文编码成“块头 + 载荷”
+vector<uint8_t> EncodeBlock(const uint8_t *data, size_t size)
+{
+    uint64_t freq[kHuffSymbols];
+    CountFrequencies(data, size, freq);
+    CanonicalHuffmanCode c = CanonicalHuffmanCode::FromFrequencies(freq);
+
+    uint64_t bits = 0;
+    for (int s = 0; s < kHuffSymbols; ++s)
+        bits += freq[s] * c.length[s];
+    const size_t huffBytes = kHuffSymbols / 2 + (size_t)((bits + 7) / 8);
+
+    vector<uint8_t> out;
+    if (huffBytes >= size)
+    { // 不可压缩：原样存储
+        out.reserve(kBlockHeaderSize + size);
+        PutLE(out, size, 4);
+        PutLE(out, size, 4);
+        PutLE(out, kModeStored, 4);
+        out.insert(out.end(), data, data + size);
+        return out;
+    }
+    out.reserve(kBlockHeaderSize + huffBytes + 8);
+    PutLE(out, size, 4);
+    PutLE(out, huffBytes, 4);
+    PutLE(out, kModeHuffman, 4);
+    for (int s = 0; s < kHuffSymbols; s += 2)
+        out.push_back((uint8_t)(c.length[s] << 4 | c.length[s + 1]));
+    BitWriter writer(out);
+    for (size_t i = 0; i < size; ++i)
+        writer.Put(c.code[data[i]], c.length[data[i]]);
+    writer.Flush();
+    return out;
+}
+
+// 按块头译出一块；frame 指向块头，frameSize 为块头 + 载荷的总长
+void DecodeBlock(const uint8_t *frame, size_t frameSize, vector<uint8_t> &out)
+{
+    if (frameSize < kBlockHeaderSize)
+        throw runtime_error("块数据不完整");
+    const size_t rawSize = (size_t)GetLE(frame, 4);
+    const size_t payload = (size_t)GetLE(frame + 4, 4);
+    const uint8_t mode = frame[8];
+    if (kBlockHeaderSize + payload > frameSize)
+        throw runtime_error("块数据不完整");
+    const uint8_t *p = frame + kBlockHeaderSize;
+    out.resize(rawSize);
+    if (mode == kModeStored)
+    {
+        if (payload != rawSize)
+            throw runtime_error("存储块长度不一致");
+        copy(p, p + payload, out.begin());
+        return;
+    }
+    if (mode != kModeHuffman || payload < (size_t)kHuffSymbols / 2)
+        throw runtime_error("未知的块模式");
+    uint8_t length[kHuffSymbols];
+    for (int s = 0; s < kHuffSymbols; s += 2)
+    {
+        length[s] = p[s / 2] >> 4;
+        length[s + 1] = p[s / 2] & 0x0f;
+    }
+    if (rawSize == 0)
+        return;
+    HuffmanTableDecoder decoder(CanonicalHuffmanCode::FromLengths(length));
+    BitReader reader(p + kHuffSymbols / 2, payload - kHuffSymbols / 2);
+    decoder.Decode(reader, out.data(), rawSize);
+}
+
+// 对 tasks 中的每个下标并行执行 fn（每个线程处理一个下标，一批最多 threads 个）
+template <class Fn>
+void RunBatch(size_t tasks, Fn fn)
+{
+    if (tasks <= 1)
+    {
+        for (size_t i = 0; i < tasks; ++i)
+            fn(i);
+        return;
+    }
+    vector<thread> workers;
+    vector<exception_ptr> errors(tasks);
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        workers.emplace_back([&, i]() {
+            try
+            {
+                fn(i);
+            }
+            catch (...)
+            {
+                errors[i] = current_exception();
+            }
+        });
+    }
+    for (thread &w : workers)
+        w.join();
+    for (exception_ptr &e : errors)
+        if (e)
+            rethrow_exception(e);
+}
+
+inline unsigned ResolveThreads(unsigned threads)
+{
+    return threads ? threads : max(1u, thread::hardware_concurrency());
+}
+} // namespace huffstream
+
+// —— 流式压缩：从 in 读到 EOF，写出完整容器；返回块数
+size_t HuffmanStreamCompress(istream &in, ostream &out, size_t blockSize = 1 << 20, unsigned threads = 0)
+{
+    using namespace huffstream;
+    if (blockSize == 0 || blockSize > (1u << 30))
+        throw invalid_argument("blockSize 需在 (0, 1 GiB] 之间");
+    threads = ResolveThreads(threads);
+
+    vector<uint8_t> head(kFileMagic, kFileMagic + 4);
+    PutLE(head, 1, 4); // 版本 1 + 3 字节保留
+    PutLE(head, blockSize, 4);
+    WriteAll(out, head);
+    uint64_t offset = head.size();
+
+    vector<uint64_t> index;
+    vector<vector<uint8_t>> raw(threads, vector<uint8_t>(blockSize));
+    vector<size_t> rawSize(threads);
+    vector<vector<uint8_t>> encoded(threads);
+    bool eof = false;
+    while (!eof)
+    {
+        // 读入一批（最多 threads 块）
+        size_t batch = 0;
+        while (batch < threads && !eof)
+        {
+            rawSize[batch] = ReadUpTo(in, raw[batch].data(), blockSize);
+            if (rawSize[batch] < blockSize)
+                eof = true;
+            if (rawSize[batch] > 0)
+                ++batch;
+        }
+        // 并行编码，按原次序写出
+        RunBatch(batch, [&](size_t i) { encoded[i] = EncodeBlock(raw[i].data(), rawSize[i]); });
+        for (size_t i = 0; i < batch; ++i)
+        {
+            index.push_back(offset);
+            WriteAll(out, encoded[i]);
+            offset += encoded[i].size();
+        }
+    }
+
+    vector<uint8_t> tail;
+    PutLE(tail, 0, 4);
+    PutLE(tail, 0, 4);
+    PutLE(tail, kModeEnd, 4);
+    uint64_t indexOffset = offset + tail.size();
+    for (uint64_t off : index)
+        PutLE(tail, off, 8);
+    PutLE(tail, index.size(), 8);
+    PutLE(tail, indexOffset, 8);
+    tail.insert(tail.end(), kTailMagic, kTailMagic + 4);
+    WriteAll(out, tail);
+    return index.size();
+}
+
+// —— 流式解压：顺序读取块头，一批 threads 块并行译码后按序写出（不需要输入可随机定位）
+size_t HuffmanStreamDecompress(istream &in, ostream &out, unsigned threads = 0)
+{
+    using namespace huffstream;
+    threads = ResolveThreads(threads);
+    uint8_t head[12];
+    if (ReadUpTo(in, head, 12) != 12 || !equal(head, head + 4, kFileMagic) || head[4] != 1)
+        throw runtime_error("不是 HUFS 容器");
+
+    vector<vector<uint8_t>> frames(threads);
+    vector<vector<uint8_t>> decoded(threads);
+    size_t blocks = 0;
+    bool end = false;
+    while (!end)
+    {
+        size_t batch = 0;
+        while (batch < threads)
+        {
+            uint8_t bh[kBlockHeaderSize];
+            if (ReadUpTo(in, bh, kBlockHeaderSize) != kBlockHeaderSize)
+                throw runtime_error("容器提前结束");
+            if (bh[8] == kModeEnd)
+            {
+                end = true;
+                break;
+            }
+            size_t payload = (size_t)GetLE(bh + 4, 4);
+            vector<uint8_t> &f = frames[batch];
+            f.assign(bh, bh + kBlockHeaderSize);
+            f.resize(kBlockHeaderSize + payload);
+            if (ReadUpTo(in, f.data() + kBlockHeaderSize, payload) != payload)
+                throw runtime_error("容器提前结束");
+            ++batch;
+        }
+        RunBatch(batch, [&](size_t i) { DecodeBlock(frames[i].data(), frames[i].size(), decoded[i]); });
+        for (size_t i = 0; i < batch; ++i)
+            WriteAll(out, decoded[i]);
+        blocks += batch;
+    }
+    return blocks;
+}
+
+// —— 随机访问：读取文件尾部的块索引，之后可以单独解压任意一块
+class HuffmanContainerReader
+{
+public:
+    explicit HuffmanContainerReader(istream &in) : in_(in)
+    {
+        using namespace huffstream;
+        uint8_t head[12];
+        in_.seekg(0);
+        if (ReadUpTo(in_, head, 12) != 12 || !equal(head, head + 4, kFileMagic))
+            throw runtime_error("不是 HUFS 容器");
+        blockSize_ = (size_t)GetLE(head + 8, 4);
+
+        uint8_t tail[20];
+        in_.seekg(-20, ios::end);
+        if (ReadUpTo(in_, tail, 20) != 20 || !equal(tail + 16, tail + 20, kTailMagic))
+            throw runtime_error("容器缺少块索引");
+        uint64_t count = GetLE(tail, 8);
+        uint64_t indexOffset = GetLE(tail + 8, 8);
+        vector<uint8_t> raw(count * 8);
+        in_.seekg((streamoff)indexOffset);
+        if (ReadUpTo(in_, raw.data(), raw.size()) != raw.size())
+            throw runtime_error("块索引不完整");
+        for (uint64_t i = 0; i < count; ++i)
+            offset_.push_back(GetLE(raw.data() + 8 * i, 8));
+    }
+
+    size_t BlockCount() const { return offset_.size(); }
+    size_t BlockSize() const { return blockSize_; }
+
+    // 解压第 i 块（对应原文 [i*BlockSize(), (i+1)*BlockSize()) ）
+    vector<uint8_t> ReadBlock(size_t i)
+    {
+        using namespace huffstream;
+        if (i >= offset_.size())
+            throw out_of_range("块编号越界");
+        in_.clear();
+        in_.seekg((streamoff)offset_[i]);
+        vector<uint8_t> frame(kBlockHeaderSize);
+        if (ReadUpTo(in_, frame.data(), kBlockHeaderSize) != kBlockHeaderSize)
+            throw runtime_error("块数据不完整");
+        size_t payload = (size_t)GetLE(frame.data() + 4, 4);
+        frame.resize(kBlockHeaderSize + payload);
+        if (ReadUpTo(in_, frame.data() + kBlockHeaderSize, payload) != payload)
+            throw runtime_error("块数据不完整");
+        vector<uint8_t> out;
+        DecodeBlock(frame.data(), frame.size(), out);
+        return out;
+    }
+
+private:
+    istream &in_;
+    size_t blockSize_ = 0;
+    vector<uint64_t> offset_;
+};
+
+// —— 分块并行压缩演示：单线程与多线程分别压缩同一段文本，校验顺序解压与随机访问
+void DemoHuffmanStream(size_t bytes, size_t blockSize)
+{
+    mt19937 rng(7);
+    string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes)
+    {
+        text += "2024-06-" + to_string(10 + rng() % 20) + " GET /api/v1/items/" + to_string(rng() % 5000) +
+                " status=" + (rng() % 10 ? "200" : "500") + " latency_ms=" + to_string(rng() % 300) + "\n";
+    }
+    text.resize(bytes);
+
+    auto mbps = [&](chrono::steady_clock::duration d) { return bytes / 1e6 / chrono::duration<double>(d).count(); };
+    string packed;
+    for (unsigned threads : {1u, max(2u, thread::hardware_concurrency())})
+    {
+        istringstream in(text);
+        ostringstream out;
+        auto t0 = chrono::steady_clock::now();
+        size_t blocks = HuffmanStreamCompress(in, out, blockSize, threads);
+        auto t1 = chrono::steady_clock::now();
+        packed = out.str();
+
+        istringstream pin(packed);
+        ostringstream back;
+        auto t2 = chrono::steady_clock::now();
+        HuffmanStreamDecompress(pin, back, threads);
+        auto t3 = chrono::steady_clock::now();
+        cout << "  " << threads << " 线程: " << blocks << " 块，" << bytes << " B -> " << packed.size()
+             << " B，压缩 " << mbps(t1 - t0) << " MB/s，解压 " << mbps(t3 - t2) << " MB/s，"
+             << (back.str() == text ? "校验通过" : "校验失败") << "\n";
+    }
+
+    istringstream rin(packed);
+    HuffmanContainerReader reader(rin);
+    size_t k = reader.BlockCount() / 2;
+    vector<uint8_t> blk = reader.ReadBlock(k);
+    bool ok = string(blk.begin(), blk.end()) == text.substr(k * reader.BlockSize(), reader.BlockSize());
+    cout << "  随机访问第 " << k << " 块（共 " << reader.BlockCount() << " 块）: " << (ok ? "与原文一致" : "不一致") << "\n";
+}
+
+/** ===================== 四、演示（与课件示例一致） =====================
  * 课件 p.147–148 的文本：
  *   "CAST CAST SAT AT A TASA"
  * 字符集 {C,A,S,T}，频度 W = {2,7,4,5}。
@@ -282,5 +1173,24 @@ int main()
     cout << "\n按 p.148：总编码长度 = ∑(频度×码长) = " << sumLen
          << "，WPL = " << ht.WPL() << "\n";
 
+    // —— 规范哈夫曼编码：码长取自上面的课件树，码字按“码长升序、同长按字符升序”重新分配。
+    CanonicalHuffmanCode canon = CanonicalHuffmanCode::FromTree(ht);
+    cout << "\n=== Canonical Huffman Codes（码长同上，WPL 不变）===\n";
+    for (char ch : chars)
+        cout << ch << " : " << canon.CodeString((uint8_t)ch) << "\n";
+
+    // —— 按位打包后的真实大小，与 01 字符串对比；再用查表译码还原。
+    vector<uint8_t> packed = HuffmanCompress((const uint8_t *)text.data(), text.size());
+    vector<uint8_t> unpacked = HuffmanDecompress(packed.data(), packed.size());
+    cout << "原文（含空格）按位压缩: " << text.size() << " B -> " << packed.size()
+         << " B（其中 136 B 为码长表与长度头），还原"
+         << (string(unpacked.begin(), unpacked.end()) == text ? "一致" : "不一致") << "\n";
+
+    cout << "\n[Benchmark] 32 MB 类日志文本\n";
+    BenchmarkHuffman(32u << 20);
+
+    cout << "\n[Stream] 64 MB 类日志文本，1 MiB 分块\n";
+    DemoHuffmanStream(64u << 20, 1u << 20);
+
     return 0;
 }
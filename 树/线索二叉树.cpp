@@ -5,6 +5,11 @@
  * - 结点：ThreadNode<T>，含 ltag/rtag（0=孩子指针，1=前驱/后继线索）
  * - 构造：从普通二叉链复制，然后进行中序线索化（含可选“带头结点”版本）
  * - 遍历：中序线索遍历（无递归、无栈）
+ * —— 扩展：
+ * - 结点由 NodeArena 成批分配，整树销毁时一次归还（元素可平凡析构时 O(块数)）
+ * - 复制、线索化、销毁全部非递归，退化成链的树也不会栈溢出
+ * - 利用线索的 STL 风格中序双向迭代器（++ 走后继线索、-- 走前驱线索），
+ *   遍历接受任意可调用对象
  *
  * 编译：g++ -std=c++17 -O2 -Wall -Wextra 线索二叉树.cpp -o tbt_demo
  */
@@ -14,6 +19,12 @@
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 using namespace std;
 template <class T>
 struct ThreadNode {
@@ -39,6 +50,69 @@ struct RawNode {
     explicit RawNode(const T& v): data(v) {}
 };
 
+// 结点池：按块批量申请内存（每块容量翻倍，至多 4096 个结点），单个释放的结点挂到空闲链上复用；
+// ReleaseAll() 直接归还所有块而不逐个析构，O(块数)——调用者须保证结点无需析构
+// 或已自行析构。非线程安全。
+template <class Node>
+class NodeArena {
+    union Slot {
+        Slot* nextFree;
+        alignas(Node) unsigned char raw[sizeof(Node)];
+    };
+    vector<unique_ptr<Slot[]>> chunks;
+    Slot* freeList = nullptr;
+    size_t bump = 0, chunkCap = 0;     // 最后一块中已切出的槽数 / 最后一块容量
+    size_t nextChunk = 16;
+
+public:
+    NodeArena() = default;
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+    NodeArena(NodeArena&& o) noexcept { swap(o); }
+    NodeArena& operator=(NodeArena&& o) noexcept {
+        if (this != &o) { NodeArena tmp(std::move(o)); swap(tmp); }
+        return *this;
+    }
+    void swap(NodeArena& o) noexcept {
+        chunks.swap(o.chunks);
+        std::swap(freeList, o.freeList);
+        std::swap(bump, o.bump);
+        std::swap(chunkCap, o.chunkCap);
+        std::swap(nextChunk, o.nextChunk);
+    }
+
+    template <class... Args>
+    Node* Create(Args&&... args) {
+        Slot* s;
+        if (freeList) { s = freeList; freeList = s->nextFree; }
+        else {
+            if (bump == chunkCap) {
+                chunks.emplace_back(new Slot[nextChunk]);
+                chunkCap = nextChunk; bump = 0;
+                if (nextChunk < 4096) nextChunk *= 2;
+            }
+            s = chunks.back().get() + bump++;
+        }
+        try { return ::new (static_cast<void*>(s)) Node(std::forward<Args>(args)...); }
+        catch (...) { s->nextFree = freeList; freeList = s; throw; }
+    }
+
+    void Destroy(Node* n) {
+        n->~Node();
+        Slot* s = reinterpret_cast<Slot*>(n);
+        s->nextFree = freeList;
+        freeList = s;
+    }
+
+    void ReleaseAll() noexcept {
+        chunks.clear();
+        freeList = nullptr;
+        bump = chunkCap = 0;
+        nextChunk = 16;
+    }
+    size_t ChunkCount() const { return chunks.size(); }
+};
+
 template <class T>
 class ThreadedBinaryTree {
 public:
@@ -48,53 +122,74 @@ private:
     TNode* head{nullptr};   // 可选：带头结点版本的头结点（中序最小前驱/最大后继）
     TNode* root{nullptr};   // 线索化后的根（真实根）
 
-    static void destroy(TNode*& p) {
-        if (!p) return;
-        // 按照“仅沿着孩子指针递归”来销毁；线索指针不递归进入
-        if (p->ltag == 0) destroy(p->left);
-        if (p->rtag == 0) destroy(p->right);
-        delete p; p=nullptr;
-    }
+    NodeArena<TNode> arena;  // 全部结点（含头结点）的来源
 
-    static TNode* copyFromRaw(const RNode* r) {
+    // 复制：显式栈保存 (源结点, 新结点) 对，初始均为“孩子”语义。
+    // 元素复制中途抛出异常时，尚未线索化的部分副本沿孩子指针逐个析构后再抛出
+    TNode* copyFromRaw(const RNode* r) {
         if (!r) return nullptr;
-        TNode* n = new TNode(r->data);
-        n->left  = copyFromRaw(r->left);
-        n->right = copyFromRaw(r->right);
-        // 初始均为“孩子”语义
-        n->ltag = (n->left  ? 0 : 1);
-        n->rtag = (n->right ? 0 : 1);
-        return n;
+        TNode* root_ = arena.Create(r->data);
+        vector<pair<const RNode*, TNode*>> st{{r, root_}};
+        try {
+            while (!st.empty()) {
+                auto [s, d] = st.back(); st.pop_back();
+                if (s->left)  { d->left  = arena.Create(s->left->data);  st.push_back({s->left,  d->left}); }
+                if (s->right) { d->right = arena.Create(s->right->data); st.push_back({s->right, d->right}); }
+                d->ltag = (d->left  ? 0 : 1);
+                d->rtag = (d->right ? 0 : 1);
+            }
+        } catch (...) {
+            vector<TNode*> del{root_};
+            while (!del.empty()) {
+                TNode* p = del.back(); del.pop_back();
+                if (p->left) del.push_back(p->left);
+                if (p->right) del.push_back(p->right);
+                arena.Destroy(p);
+            }
+            throw;
+        }
+        return root_;
     }
 
-    // 中序线索化：prev 始终指向“中序前驱”
+    // 中序线索化（非递归）：显式栈做中序，prev 始终指向“中序前驱”。
+    // 访问 p 时它的左子树已走完、右孩子尚未进入，改写 p->left 与 prev->right 都是安全的
     static void inorderThreading(TNode* p, TNode*& prev) {
-        if (!p) return;
-        if (p->ltag == 0) inorderThreading(p->left, prev); // 左子树
-        // 处理当前结点 p 与前驱 prev 的线索
-        if (p->left == nullptr) { p->ltag = 1; p->left  = prev; }
-        if (prev && prev->right == nullptr) { prev->rtag = 1; prev->right = p; }
-        prev = p;
-        if (p->rtag == 0) inorderThreading(p->right, prev); // 右子树
+        vector<TNode*> st;
+        while (p || !st.empty()) {
+            while (p) { st.push_back(p); p = (p->ltag == 0) ? p->left : nullptr; }
+            p = st.back(); st.pop_back();
+            TNode* right = (p->rtag == 0) ? p->right : nullptr;
+            if (p->left == nullptr) { p->ltag = 1; p->left  = prev; }
+            if (prev && prev->right == nullptr) { prev->rtag = 1; prev->right = p; }
+            prev = p;
+            p = right;
+        }
     }
 
 public:
     ThreadedBinaryTree() = default;
     ~ThreadedBinaryTree() { clear(); }
 
+    ThreadedBinaryTree(const ThreadedBinaryTree&) = delete;
+    ThreadedBinaryTree& operator=(const ThreadedBinaryTree&) = delete;
+
+    // 销毁：元素可平凡析构时直接归还全部内存块，O(块数)；否则沿线索按中序逐个析构
+    // （先求后继再析构当前结点——后继只会落在右子树或尚未访问的祖先上）
     void clear() {
-        // 如果有头结点，则从 head->left 开始销毁
-        if (head) {
-            TNode* realRoot = head->left;
-            destroy(realRoot);
-            delete head; head = nullptr; root = nullptr;
-        } else {
-            destroy(root);
-            root = nullptr;
+        if (!is_trivially_destructible<T>::value) {
+            for (TNode* p = first(root); p && p != head; ) {
+                TNode* nx = next(p);
+                arena.Destroy(p);
+                p = nx;
+            }
+            if (head) arena.Destroy(head);
         }
+        head = nullptr; root = nullptr;
+        arena.ReleaseAll();
     }
 
     // 从普通二叉链（RawNode）复制并线索化；useHead=true 生成带头结点版本
+    // 复制失败时树保持为空（头结点也一并释放）
     void BuildFromRawInorderThreaded(const RNode* rawRoot, bool useHeadNode = true) {
         clear();
         if (!useHeadNode) {
@@ -102,8 +197,8 @@ public:
             TNode* prev = nullptr;
             inorderThreading(root, prev);
         } else {
-            head = new TNode(); // 头结点 data 默认
-            root = copyFromRaw(rawRoot);
+            head = arena.Create(); // 头结点 data 默认
+            try { root = copyFromRaw(rawRoot); } catch (...) { clear(); throw; }
             head->ltag = 0; head->left = root;   // 头结点左指针指向根
             head->rtag = 1; head->right = head;  // 头结点右线索回指自身
             TNode* prev = head;
@@ -129,21 +224,31 @@ public:
         return p;
     }
 
-    // 中序线索遍历（不带头/带头都支持）：不使用递归和栈
-    void InOrderTraverse(void (*visit)(const T&)) const {
+    // 中序的前驱：若 ltag=1，直接线索；否则到左子树最右
+    static TNode* prev(TNode* p) {
+        if (!p) return nullptr;
+        if (p->ltag == 1) return p->left;
+        p = p->left;
+        while (p && p->rtag == 0) p = p->right;
+        return p;
+    }
+
+    // 中序线索遍历（不带头/带头都支持）：不使用递归和栈；visit 可为任意可调用对象
+    template <class Visit>
+    void InOrderTraverse(Visit visit) const {
         if (head) {
             // 带头结点：从 head->left 的最左开始，直到回到 head
             TNode* p = head->left;
             if (!p) return;
             p = first(p);
             while (p && p != head) {
-                visit(p->data);
+                visit(static_cast<const T&>(p->data));
                 p = next(p);
             }
         } else {
             TNode* p = first(root);
             while (p) {
-                visit(p->data);
+                visit(static_cast<const T&>(p->data));
                 p = next(p);
             }
         }
@@ -152,6 +257,40 @@ public:
     // 获取真实根（线索化后的树根，便于测试）
     const TNode* GetRoot() const { return root; }
 
+    // ------------------ 中序双向迭代器（沿线索行走，单步均摊 O(1)，无栈） ------------------
+    // end() 在带头结点时为 head，否则为 nullptr；对 end() 做 -- 得到中序最后一个结点
+    class const_iterator {
+        const ThreadedBinaryTree* tree{nullptr};
+        TNode* p{nullptr};
+        friend class ThreadedBinaryTree;
+        const_iterator(const ThreadedBinaryTree* t, TNode* n) : tree(t), p(n) {}
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        const_iterator() = default;
+        reference operator*() const { return p->data; }
+        pointer operator->() const { return &p->data; }
+        const_iterator& operator++() { p = next(p); if (!p) p = tree->head; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++*this; return t; }
+        const_iterator& operator--() {
+            if (p == tree->head) {                     // end() 的前一个：中序最后一个结点
+                p = tree->root;
+                while (p && p->rtag == 0) p = p->right;
+            } else {
+                p = prev(p);
+            }
+            return *this;
+        }
+        const_iterator operator--(int) { const_iterator t = *this; --*this; return t; }
+        bool operator==(const const_iterator& o) const { return p == o.p; }
+        bool operator!=(const const_iterator& o) const { return p != o.p; }
+    };
+    const_iterator begin() const { return const_iterator(this, root ? first(root) : head); }
+    const_iterator end() const { return const_iterator(this, head); }
+
     // ----------- 工具：构造一个示例 RawNode 树（便于独立测试） -----------
     static RNode* MakeSampleRaw() {
         //        A
@@ -169,12 +308,17 @@ public:
         return A;
     }
 
-    // 清理 Raw 树（普通二叉链）
+    // 清理 Raw 树（普通二叉链），显式栈，非递归
     static void DestroyRaw(RNode*& r) {
-        if (!r) return;
-        DestroyRaw(r->left);
-        DestroyRaw(r->right);
-        delete r; r=nullptr;
+        vector<RNode*> st;
+        if (r) st.push_back(r);
+        while (!st.empty()) {
+            RNode* p = st.back(); st.pop_back();
+            if (p->left) st.push_back(p->left);
+            if (p->right) st.push_back(p->right);
+            delete p;
+        }
+        r = nullptr;
     }
 };
 
@@ -187,7 +331,26 @@ int main(){
     tbt.BuildFromRawInorderThreaded(raw, /*useHeadNode=*/true);
     cout<<"中序线索遍历：";
     tbt.InOrderTraverse(print_char);
+    cout<<"\n迭代器正序：";
+    for (char c : tbt) cout<<c<<' ';
+    cout<<"\n迭代器逆序：";
+    for (auto it = tbt.end(); it != tbt.begin(); ) { --it; cout<<*it<<' '; }
     cout<<"\n";
     TBT::DestroyRaw(raw);
+
+    // 退化成链（每个结点只有左孩子）的深树：复制、线索化、遍历、销毁均不递归
+    using IBT = ThreadedBinaryTree<int>;
+    const int depth = 1000000;
+    IBT::RNode* chain = nullptr;
+    for (int i = 0; i < depth; ++i) { auto* n = new IBT::RNode(i); n->left = chain; chain = n; }
+    auto t0 = chrono::steady_clock::now();
+    IBT deep;
+    deep.BuildFromRawInorderThreaded(chain, /*useHeadNode=*/false);
+    long long sum = 0;
+    for (int x : deep) sum += x;
+    auto t1 = chrono::steady_clock::now();
+    cout<<"深度 "<<depth<<" 的链：中序和 "<<sum<<"，复制+线索化+遍历 "
+        <<chrono::duration<double, milli>(t1 - t0).count()<<" ms\n";
+    IBT::DestroyRaw(chain);
     return 0;
 }
\ No newline at end of file
@@ -8,18 +8,38 @@
  *
  * 说明：
  *  1) 位序使用 1-based（从 1 开始），与课件一致（见 P13、P19）。
- *  2) 本实现为“固定容量”的顺序表：当 count==maxSize 时，插入失败。
+ *  2) 默认为“固定容量”的顺序表：当 count==maxSize 时，插入失败。
  *    （与课件 Insert 伪码一致：已满返回 false，见 P28）
+ *     构造时传入 SqListGrowth::Geometric 则表满时容量按 2 倍增长，
+ *     均摊 O(1) 尾插；Reserve / ShrinkToFit 可显式调整容量。
  *  3) 所有接口命名、签名均与课件对齐，便于学习与对照。
+ *  4) 存储区只构造 [0, count) 内的元素（未用容量是裸内存），扩容时
+ *     移动而非复制元素；平凡可复制类型的整体移位直接用 memmove。
+ *  5) 课件 Difference 是 O(n·m) 的双重循环；文末另给出哈希与
+ *     “排序 + 归并”两组 O(n+m) / O((n+m)log) 的并、交、差。
  ************************************************************/
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 // -------------------------- 配置 ---------------------------
 #ifndef DEFAULT_SIZE
 #define DEFAULT_SIZE 100   // 课件原型：SqList(int size=DEFAULT_SIZE)（见 P23）
 #endif
 
+// 容量策略：Fixed 与课件一致（表满插入失败）；Geometric 表满时 2 倍扩容
+enum class SqListGrowth { Fixed, Geometric };
+
 // 为了便于替换元素类型，定义一个 ElemType（也可直接在模板上使用）
 template <class ElemType>
 class SqList {
@@ -27,44 +47,139 @@ protected:
     // ---------- P22：顺序表实现的数据成员 ----------
     int        count;    // 元素个数（当前长度）
     int        maxSize;  // 最大可容纳元素个数（容量）
-    ElemType*  elems;    // 元素存储空间（连续内存）
+    ElemType*  elems;    // 元素存储空间（连续内存，仅 [0,count) 已构造）
+    SqListGrowth growth; // 表满时的处理策略
+
+    static constexpr bool kTrivial = std::is_trivially_copyable<ElemType>::value;
+
+    static ElemType* Allocate(int n) {
+        return std::allocator<ElemType>().allocate(static_cast<std::size_t>(n));
+    }
+    static void Deallocate(ElemType* p, int n) {
+        if (p) std::allocator<ElemType>().deallocate(p, static_cast<std::size_t>(n));
+    }
+
+    // 把 [0,count) 搬到容量为 newCap 的新空间：平凡类型 memcpy，
+    // 否则逐个移动构造（移动可能抛异常时退回复制，保证原表不被破坏）
+    void Reallocate(int newCap) {
+        ElemType* buf = Allocate(newCap);
+        if constexpr (kTrivial) {
+            if (count > 0) std::memcpy(static_cast<void*>(buf), elems, sizeof(ElemType) * count);
+        } else {
+            try {
+                for (int i = 0; i < count; ++i)
+                    ::new (static_cast<void*>(buf + i)) ElemType(std::move_if_noexcept(elems[i]));
+            } catch (...) {
+                // 已构造的前缀在 move_if_noexcept 下只可能来自复制，原表完好
+                Deallocate(buf, newCap);
+                throw;
+            }
+            std::destroy(elems, elems + count);
+        }
+        Deallocate(elems, maxSize);
+        elems = buf;
+        maxSize = newCap;
+    }
+
+    // 保证还能再放 extra 个元素；Fixed 策略下空间不足返回 false
+    bool EnsureRoom(int extra) {
+        if (extra <= maxSize - count) return true;
+        if (growth == SqListGrowth::Fixed) return false;
+        long long need = static_cast<long long>(count) + extra;
+        long long cap = std::max<long long>(maxSize, 1);
+        while (cap < need) cap *= 2;
+        if (cap > 0x7fffffff) cap = 0x7fffffff;
+        if (cap < need) return false;
+        Reallocate(static_cast<int>(cap));
+        return true;
+    }
+
+    // 在下标 i 处打开 n 个槽位：[i,count) 右移 n 位，返回后 [i,i+n) 为未构造空间
+    // 非平凡类型：由尾向前逐个移动构造到新位置并析构原槽位（假定移动构造不抛异常）
+    void OpenGap(int i, int n) {
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(elems + i + n), elems + i, sizeof(ElemType) * (count - i));
+        } else {
+            for (int k = count - 1; k >= i; --k) {
+                ::new (static_cast<void*>(elems + k + n)) ElemType(std::move(elems[k]));
+                elems[k].~ElemType();
+            }
+        }
+    }
+
+    // 关闭 [i,i+n) 处的空洞（这些槽位已析构）：[i+n,count) 左移 n 位（同样假定移动不抛异常）
+    void CloseGap(int i, int n) {
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(elems + i), elems + i + n, sizeof(ElemType) * (count - i - n));
+        } else {
+            for (int k = i + n; k < count; ++k) {
+                ::new (static_cast<void*>(elems + k - n)) ElemType(std::move(elems[k]));
+                elems[k].~ElemType();
+            }
+        }
+    }
 
 public:
     // ---------- P23：抽象数据类型方法声明 ----------
     // 构造：构造一个最大元素个数为 size 的空顺序表（P25）
-    explicit SqList(int size = DEFAULT_SIZE)
-        : count(0), maxSize(size), elems(nullptr)
+    explicit SqList(int size = DEFAULT_SIZE, SqListGrowth policy = SqListGrowth::Fixed)
+        : count(0), maxSize(size), elems(nullptr), growth(policy)
     {
         if (maxSize <= 0) maxSize = DEFAULT_SIZE;
-        elems = new ElemType[maxSize];        // 分配顺序存储空间（连续数组）
+        elems = Allocate(maxSize);            // 分配顺序存储空间（连续数组，元素按需构造）
     }
 
     // 析构：销毁线性表，释放 elems（P26、P9）
     virtual ~SqList() {
-        delete[] elems;
+        std::destroy(elems, elems + count);
+        Deallocate(elems, maxSize);
         elems = nullptr;
         count = maxSize = 0;
     }
 
     // 复制构造：深拷贝，确保两个表互不影响（P24 原型）
     SqList(const SqList& source)
-        : count(source.count), maxSize(source.maxSize), elems(new ElemType[maxSize])
+        : count(0), maxSize(source.maxSize), elems(Allocate(source.maxSize)), growth(source.growth)
+    {
+        try {
+            std::uninitialized_copy(source.elems, source.elems + source.count, elems);
+        } catch (...) {
+            Deallocate(elems, maxSize);
+            throw;
+        }
+        count = source.count;
+    }
+
+    // 移动构造：接管存储区，source 变为容量 0 的空表。之后可析构、可被赋值；
+    // Geometric 策略下插入会自动扩容，Fixed 策略下须先 Reserve，否则插入因表满返回 false
+    SqList(SqList&& source) noexcept
+        : count(source.count), maxSize(source.maxSize), elems(source.elems), growth(source.growth)
     {
-        for (int i = 0; i < count; ++i) elems[i] = source.elems[i];
+        source.elems = nullptr;
+        source.count = source.maxSize = 0;
     }
 
-    // 赋值重载：深拷贝（P24 原型）
+    // 赋值重载：深拷贝（P24 原型）；复制-交换，失败时 *this 不变
     SqList& operator=(const SqList& source) {
         if (this == &source) return *this;
-        ElemType* newBuf = new ElemType[source.maxSize];
-        for (int i = 0; i < source.count; ++i) newBuf[i] = source.elems[i];
-        delete[] elems;
-        elems   = newBuf;
-        maxSize = source.maxSize;
-        count   = source.count;
+        SqList tmp(source);
+        Swap(tmp);
+        return *this;
+    }
+
+    SqList& operator=(SqList&& source) noexcept {
+        if (this == &source) return *this;
+        Swap(source);
         return *this;
     }
 
+    void Swap(SqList& other) noexcept {
+        std::swap(count, other.count);
+        std::swap(maxSize, other.maxSize);
+        std::swap(elems, other.elems);
+        std::swap(growth, other.growth);
+    }
+
     // -------------------- Ⅲ. 引用型操作（P10-P14） --------------------
     // 判空：若空返回 true，否则 false（P11）
     bool Empty() const { return count == 0; }
@@ -72,6 +187,11 @@ public:
     // 求长度：返回元素个数（P12）
     int Length() const { return count; }
 
+    // 容量与连续存储首地址（供排序、memcpy 等批量算法直接使用）
+    int Capacity() const { return maxSize; }
+    ElemType* Data() { return elems; }
+    const ElemType* Data() const { return elems; }
+
     // 按位序（1-based）取值：e 返回第 position 个元素值（P13）
     bool GetElem(int position, ElemType& e) const {
         if (position < 1 || position > count) return false;      // 位置非法
@@ -86,7 +206,10 @@ public:
 
     // -------------------- Ⅳ. 加工型操作（P15-P19） --------------------
     // 置空：将线性表重置为长度 0（容量保留）（P16）
-    void Clear() { count = 0; }
+    void Clear() {
+        std::destroy(elems, elems + count);
+        count = 0;
+    }
 
     // 置值：将第 position 个元素改为 e（P17）
     bool SetElem(int position, const ElemType& e) {
@@ -95,38 +218,92 @@ public:
         return true;
     }
 
-    // 插入：在第 position 个位置“前”插入 e（1 ≤ position ≤ Length()+1）（P19、P28-P29）
-    // 成功返回 true；若已满或位置非法返回 false。
-    bool Insert(int position, const ElemType& e) {
-        if (count == maxSize) return false;                       // 表满（与 P28 一致）
-        if (position < 1 || position > count + 1) return false;   // 位置非法（与 P28 一致）
+    // 容量管理：Reserve 只增不减；ShrinkToFit 把容量收缩到 max(count,1)
+    void Reserve(int capacity) {
+        if (capacity > maxSize) Reallocate(capacity);
+    }
+    void ShrinkToFit() {
+        int target = count > 0 ? count : 1;
+        if (target < maxSize) Reallocate(target);
+    }
+    void SetGrowth(SqListGrowth policy) { growth = policy; }
 
+    // 原位构造插入：先构造出值再移位，因此 args 引用表内元素也安全
+    template <class... Args>
+    bool Emplace(int position, Args&&... args) {
+        if (position < 1 || position > count + 1) return false;   // 位置非法（与 P28 一致）
+        if (count == maxSize && growth == SqListGrowth::Fixed) return false;   // 表满（与 P28 一致）
+        ElemType value(std::forward<Args>(args)...);
+        if (!EnsureRoom(1)) return false;
         // 从尾到 position 依次右移，空出插入位（P29 动图思想）
-        for (int i = count; i >= position; --i) {
-            elems[i] = elems[i - 1];
-        }
-        elems[position - 1] = e;
+        OpenGap(position - 1, 1);
+        ::new (static_cast<void*>(elems + position - 1)) ElemType(std::move(value));
         ++count;
         return true;
     }
 
+    // 插入：在第 position 个位置“前”插入 e（1 ≤ position ≤ Length()+1）（P19、P28-P29）
+    // 成功返回 true；若已满（Fixed 策略）或位置非法返回 false。
+    bool Insert(int position, const ElemType& e) { return Emplace(position, e); }
+    bool Insert(int position, ElemType&& e) { return Emplace(position, std::move(e)); }
+
+    // 尾插：即课件中的 Insert(Length()+1, e)
+    bool PushBack(const ElemType& e) { return Emplace(count + 1, e); }
+    bool PushBack(ElemType&& e) { return Emplace(count + 1, std::move(e)); }
+
+    // 区间插入：在第 position 个位置前依次插入 [first,last)，整体只移位一次，O(n + len)
+    // 源区间可以来自本表（先复制到临时区再插入）
+    template <class ForwardIt>
+    bool InsertRange(int position, ForwardIt first, ForwardIt last) {
+        if (position < 1 || position > count + 1) return false;
+        long long len = std::distance(first, last);
+        if (len <= 0) return true;
+        if (len > 0x7fffffff - count) return false;
+        int n = static_cast<int>(len);
+        if (n > maxSize - count && growth == SqListGrowth::Fixed) return false;
+        // 先复制到一块裸内存暂存区：与本表别名或 EnsureRoom 失效迭代器时都安全。
+        // 不用 vector<ElemType>，因为 vector<bool> 没有连续的 data()
+        struct Staging {
+            ElemType* p;
+            int cap, built;
+            ~Staging() { std::destroy(p, p + built); Deallocate(p, cap); }
+        } staged{Allocate(n), n, 0};
+        std::uninitialized_copy(first, last, staged.p);
+        staged.built = n;
+        if (!EnsureRoom(n)) return false;
+        int at = position - 1;
+        OpenGap(at, n);
+        if constexpr (kTrivial) {
+            std::memcpy(static_cast<void*>(elems + at), staged.p, sizeof(ElemType) * n);
+        } else {
+            std::uninitialized_move(staged.p, staged.p + n, elems + at);
+        }
+        count += n;
+        return true;
+    }
+
     // 删除（带出参）：删除第 position 个元素，用 e 返回其值（1 ≤ position ≤ Length()）（P18、P31-P32）
     bool Delete(int position, ElemType& e) {
         if (position < 1 || position > count) return false;       // 位置非法（与 P31 一致）
 
-        e = elems[position - 1];                                  // 返回被删值（P32）
-        // 从 position+1 起的元素整体左移填补空位（P32）
-        for (int i = position; i < count; ++i) {
-            elems[i - 1] = elems[i];
-        }
-        --count;
-        return true;
+        e = std::move(elems[position - 1]);                       // 返回被删值（P32）
+        return Delete(position);
     }
 
     // 删除（无出参重载）：仅删除，不关心被删值（P24 原型含此重载）
     bool Delete(int position) {
-        ElemType tmp;
-        return Delete(position, tmp);
+        return DeleteRange(position, 1);
+    }
+
+    // 区间删除：删除从第 position 个起的 n 个元素，后继元素只左移一次，O(Length())
+    bool DeleteRange(int position, int n) {
+        if (position < 1 || n < 0 || n > count - position + 1) return false;
+        if (n == 0) return true;
+        std::destroy(elems + position - 1, elems + position - 1 + n);
+        // 从 position+n 起的元素整体左移填补空位（P32）
+        CloseGap(position - 1, n);
+        count -= n;
+        return true;
     }
 };
 
@@ -168,6 +345,138 @@ void Difference(const SqList<ElemType>& la,
     }
 }
 
+// ---------------- 快速集合运算：哈希（保持 la 次序）----------------
+// 与课件 Difference 结果完全一致（含 la 中的重复元素），但每个 la 元素
+// 只做一次 O(1) 期望的哈希查找：总 O(n+m)，而非 O(n·m)
+template <class ElemType>
+void DifferenceHash(const SqList<ElemType>& la,
+                    const SqList<ElemType>& lb,
+                    SqList<ElemType>& lc)
+{
+    std::unordered_set<ElemType> inB(lb.Data(), lb.Data() + lb.Length());
+    lc.Clear();
+    lc.Reserve(la.Length());
+    for (int i = 0; i < la.Length(); ++i)
+        if (!inB.count(la.Data()[i])) lc.PushBack(la.Data()[i]);
+}
+
+// 交集：la 中同时出现在 lb 的元素（保持 la 次序与重数）
+template <class ElemType>
+void IntersectionHash(const SqList<ElemType>& la,
+                      const SqList<ElemType>& lb,
+                      SqList<ElemType>& lc)
+{
+    std::unordered_set<ElemType> inB(lb.Data(), lb.Data() + lb.Length());
+    lc.Clear();
+    lc.Reserve(std::min(la.Length(), lb.Length()));
+    for (int i = 0; i < la.Length(); ++i)
+        if (inB.count(la.Data()[i])) lc.PushBack(la.Data()[i]);
+}
+
+// 并集：先放入 la，再把 lb 中不在 la 的元素（首次出现）追加到尾部
+template <class ElemType>
+void UnionHash(const SqList<ElemType>& la,
+               const SqList<ElemType>& lb,
+               SqList<ElemType>& lc)
+{
+    std::unordered_set<ElemType> seen(la.Data(), la.Data() + la.Length());
+    lc.Clear();
+    lc.Reserve(la.Length() + lb.Length());
+    lc.InsertRange(1, la.Data(), la.Data() + la.Length());
+    for (int i = 0; i < lb.Length(); ++i)
+        if (seen.insert(lb.Data()[i]).second) lc.PushBack(lb.Data()[i]);
+}
+
+// ------------- 快速集合运算：排序 + 归并（只需 operator<）-------------
+// 两表各自排序去重后一次线性归并，O(n log n + m log m)；
+// 结果升序且无重复（按数学集合语义），不依赖 std::hash
+template <class ElemType>
+std::vector<ElemType> SortedDistinct(const SqList<ElemType>& L) {
+    std::vector<ElemType> v(L.Data(), L.Data() + L.Length());
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end(), [](const ElemType& x, const ElemType& y) {
+        return !(x < y) && !(y < x);
+    }), v.end());
+    return v;
+}
+
+// which：0 并、1 交、2 差，三者共用一个归并循环
+template <class ElemType>
+void SortedSetOp(const SqList<ElemType>& la, const SqList<ElemType>& lb,
+                 SqList<ElemType>& lc, int which)
+{
+    std::vector<ElemType> a = SortedDistinct(la), b = SortedDistinct(lb);
+    lc.Clear();
+    lc.Reserve(static_cast<int>(which == 0 ? a.size() + b.size() : a.size()));
+    std::size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) {                      // 只在 A 中
+            if (which != 1) lc.PushBack(std::move(a[i]));
+            ++i;
+        } else if (b[j] < a[i]) {               // 只在 B 中
+            if (which == 0) lc.PushBack(std::move(b[j]));
+            ++j;
+        } else {                                // 两者共有
+            if (which != 2) lc.PushBack(std::move(a[i]));
+            ++i; ++j;
+        }
+    }
+    if (which != 1) lc.InsertRange(lc.Length() + 1, std::make_move_iterator(a.begin() + i),
+                                   std::make_move_iterator(a.end()));
+    if (which == 0) lc.InsertRange(lc.Length() + 1, std::make_move_iterator(b.begin() + j),
+                                   std::make_move_iterator(b.end()));
+}
+
+template <class ElemType>
+void UnionSorted(const SqList<ElemType>& la, const SqList<ElemType>& lb, SqList<ElemType>& lc)
+{ SortedSetOp(la, lb, lc, 0); }
+
+template <class ElemType>
+void IntersectionSorted(const SqList<ElemType>& la, const SqList<ElemType>& lb, SqList<ElemType>& lc)
+{ SortedSetOp(la, lb, lc, 1); }
+
+template <class ElemType>
+void DifferenceSorted(const SqList<ElemType>& la, const SqList<ElemType>& lb, SqList<ElemType>& lc)
+{ SortedSetOp(la, lb, lc, 2); }
+
+// ------------------- 性能对比：课件差集 vs 快速差集 -------------------
+// n 个随机整数（取值 [0,2n)）的两张表求差集；同时校验三种结果一致
+inline void BenchmarkDifference(int n) {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 rng(20240601u);
+    std::uniform_int_distribution<int> dist(0, 2 * n - 1);
+    SqList<int> A(n), B(n), C1(n), C2(1, SqListGrowth::Geometric), C3(1, SqListGrowth::Geometric);
+    for (int i = 0; i < n; ++i) { A.PushBack(dist(rng)); B.PushBack(dist(rng)); }
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    auto t0 = Clock::now();
+    Difference(A, B, C1);
+    auto t1 = Clock::now();
+    DifferenceHash(A, B, C2);
+    auto t2 = Clock::now();
+    DifferenceSorted(A, B, C3);
+    auto t3 = Clock::now();
+
+    bool sameHash = C1.Length() == C2.Length() &&
+                    std::equal(C1.Data(), C1.Data() + C1.Length(), C2.Data());
+    SqList<int> expect(1, SqListGrowth::Geometric);
+    std::vector<int> sortedC1 = SortedDistinct(C1);
+    expect.InsertRange(1, sortedC1.begin(), sortedC1.end());
+    bool sameSorted = expect.Length() == C3.Length() &&
+                      std::equal(expect.Data(), expect.Data() + expect.Length(), C3.Data());
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "n=" << n << "  |A-B|=" << C1.Length() << "\n"
+              << "  课件 Difference  O(n*m)     : " << ms(t0, t1) << " ms\n"
+              << "  DifferenceHash   O(n+m)     : " << ms(t1, t2) << " ms"
+              << (sameHash ? "  (结果一致)" : "  (结果不一致!)") << "\n"
+              << "  DifferenceSorted O(n log n) : " << ms(t2, t3) << " ms"
+              << (sameSorted ? "  (结果一致)" : "  (结果不一致!)") << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
 // ----------------------------- 演示主程序 ------------------------------
 int main() {
     std::cout << "==== 顺序表 SqList 演示（与课件接口一致） ====\n\n";
@@ -221,6 +530,30 @@ int main() {
     Difference(A, B, C);      // C = A - B = {1,3,5}
     PrintList("差集 C=A-B", C);
 
+    // 7) 可增长顺序表：Geometric 策略下表满自动 2 倍扩容；区间插入/删除
+    SqList<int> G(2, SqListGrowth::Geometric);
+    for (int x = 1; x <= 5; ++x) G.PushBack(x);
+    std::cout << "\n尾插 5 个元素后 Capacity=" << G.Capacity() << "\n";
+    int mid[] = {100, 200, 300};
+    G.InsertRange(3, mid, mid + 3);          // 在第 3 个位置前插入 3 个
+    PrintList("InsertRange(3,..)", G);
+    G.DeleteRange(2, 4);                     // 删除第 2..5 个
+    PrintList("DeleteRange(2,4)", G);
+    G.ShrinkToFit();
+    std::cout << "ShrinkToFit 后 Capacity=" << G.Capacity() << "\n";
+
+    // 8) 快速集合运算（哈希保持 A 的次序；排序版输出升序集合）
+    SqList<int> D(1, SqListGrowth::Geometric);
+    UnionHash(A, B, D);         PrintList("UnionHash", D);
+    IntersectionHash(A, B, D);  PrintList("IntersectionHash", D);
+    DifferenceHash(A, B, D);    PrintList("DifferenceHash", D);
+    UnionSorted(A, B, D);       PrintList("UnionSorted", D);
+    IntersectionSorted(A, B, D);PrintList("IntersectionSorted", D);
+    DifferenceSorted(A, B, D);  PrintList("DifferenceSorted", D);
+
+    std::cout << "\n";
+    BenchmarkDifference(20000);
+
     std::cout << "\n==== 演示结束 ====\n";
     return 0;                  // 析构自动触发（P26/P9）
 }
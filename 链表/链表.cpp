@@ -9,14 +9,24 @@
  *  - P57–P61：循环单链表接口及实现要点
  *  - P62–P66：循环链表应用——约瑟夫问题示例
  *  - P72–P74：LinkList（缓存当前位置与元素个数）
+ *  - 扩展：UnrolledLinkList（块状链表，结点池分配，游标可双向移动）
  *
  * 统一约定：
  *  - “位序”为 1-based（与课件一致）。
  *  - 采用“头结点/哨兵”（sentinel）简化边界处理（P77）。
  *  - Insert/ Delete 的返回值：成功 true，越界/非法 false。
  ************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
 
 //======================== P45: 结点类模板 ========================
 template <class ElemType>
@@ -429,6 +439,416 @@ public:
 };
 
 
+//==================================================================
+//  扩展：块状链表 UnrolledLinkList（在 P72–P74 LinkList 基础上改进）
+//  - 每个“块”顺序存放至多 BlockCap 个元素，块之间双向链接：
+//    顺序访问时大部分步进在同一块的连续内存里完成，缓存友好
+//  - 块由 BlockPool 成批分配、回收到空闲链，避免“一元素一次 new”
+//  - 游标缓存（curBlock/curStart）可前后双向移动；定位时在
+//    头、尾、游标三个起点中选距目标最近者，回退访问不必从头走
+//  - Splice：同一结点池的两表拼接只改几根指针（位于块边界时 O(1)，
+//    否则先把一个块一分为二，O(BlockCap)）
+//==================================================================
+template <class ElemType, int BlockCap>
+struct UnrolledBlock {
+    UnrolledBlock* prev = nullptr;
+    UnrolledBlock* next = nullptr;
+    int size = 0;                                               // 块内已构造元素个数
+    alignas(ElemType) unsigned char raw[sizeof(ElemType) * BlockCap];   // 仅 [0,size) 已构造
+
+    ElemType* At(int i) { return std::launder(reinterpret_cast<ElemType*>(raw) + i); }
+};
+
+// 结点池：按块批量申请内存（每批容量翻倍，至多 1024 块），释放的块挂到空闲链上复用。
+// 内存只在池析构时归还系统；池由多个表经 shared_ptr 共享，非线程安全。
+template <class Block>
+class BlockPool {
+    union Slot {
+        Slot* nextFree;
+        alignas(Block) unsigned char raw[sizeof(Block)];
+    };
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    Slot* freeList = nullptr;
+    std::size_t nextChunk = 8;
+
+    void Grow() {
+        chunks.emplace_back(new Slot[nextChunk]);
+        Slot* c = chunks.back().get();
+        for (std::size_t i = 0; i < nextChunk; ++i) {
+            c[i].nextFree = freeList;
+            freeList = c + i;
+        }
+        if (nextChunk < 1024) nextChunk *= 2;
+    }
+
+public:
+    BlockPool() = default;
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    Block* Acquire() {
+        if (!freeList) Grow();
+        Slot* s = freeList;
+        freeList = s->nextFree;
+        return ::new (static_cast<void*>(s)) Block();
+    }
+
+    void Release(Block* b) {
+        b->~Block();
+        Slot* s = reinterpret_cast<Slot*>(b);
+        s->nextFree = freeList;
+        freeList = s;
+    }
+};
+
+// 默认块容量：约 512 字节一块，至少 4 个元素
+template <class ElemType>
+constexpr int UnrolledDefaultCap() {
+    return sizeof(ElemType) * 4 >= 512 ? 4 : static_cast<int>(512 / sizeof(ElemType));
+}
+
+template <class ElemType, int BlockCap = UnrolledDefaultCap<ElemType>()>
+class UnrolledLinkList {
+    static_assert(BlockCap >= 2, "BlockCap 至少为 2（满块需要一分为二）");
+public:
+    using Block = UnrolledBlock<ElemType, BlockCap>;
+    using Pool  = BlockPool<Block>;
+
+protected:
+    std::shared_ptr<Pool> pool;           // 结点池（可在多个表之间共享）
+    Block* first;                          // 首块（空表为 nullptr）
+    Block* last;                           // 尾块
+    int count;                             // 元素个数
+    mutable Block* curBlock;               // 游标缓存：最近访问的块（nullptr 表示无缓存）
+    mutable int curStart;                  // curBlock 首元素的 0-based 下标
+
+    // 块内移位：[off,size) 右移一格，空出 off（off 处变为未构造）
+    static void OpenSlot(Block* b, int off) {
+        for (int k = b->size - 1; k >= off; --k) {
+            ::new (static_cast<void*>(b->At(k + 1))) ElemType(std::move(*b->At(k)));
+            b->At(k)->~ElemType();
+        }
+    }
+
+    // 块内移位：off 处已析构，(off,size) 左移一格补位
+    static void CloseSlot(Block* b, int off) {
+        for (int k = off + 1; k < b->size; ++k) {
+            ::new (static_cast<void*>(b->At(k - 1))) ElemType(std::move(*b->At(k)));
+            b->At(k)->~ElemType();
+        }
+    }
+
+    // 把 src 的 [sOff, sOff+n) 移动到 dst 的 [dOff, dOff+n)（目标为未构造空间），不改 size
+    static void MoveElems(Block* dst, int dOff, Block* src, int sOff, int n) {
+        for (int i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(dst->At(dOff + i))) ElemType(std::move(*src->At(sOff + i)));
+            src->At(sOff + i)->~ElemType();
+        }
+    }
+
+    Block* NewBlockAfter(Block* b) {
+        Block* nb = pool->Acquire();
+        nb->prev = b;
+        nb->next = b ? b->next : first;
+        if (nb->next) nb->next->prev = nb; else last = nb;
+        if (b) b->next = nb; else first = nb;
+        return nb;
+    }
+
+    void Unlink(Block* b) {
+        if (b->prev) b->prev->next = b->next; else first = b->next;
+        if (b->next) b->next->prev = b->prev; else last = b->prev;
+    }
+
+    // 把块 b 在块内偏移 off 处一分为二：[off,size) 移到紧随其后的新块
+    void SplitAt(Block* b, int off) {
+        Block* nb = NewBlockAfter(b);
+        MoveElems(nb, 0, b, off, b->size - off);
+        nb->size = b->size - off;
+        b->size = off;
+    }
+
+    // 定位 0-based 下标 idx（0 ≤ idx < count）：返回所在块，off 为块内偏移，并更新游标
+    Block* Locate(int idx, int& off) const {
+        Block* b;
+        int start;
+        int dHead = idx, dTail = count - 1 - idx;
+        int dCur  = curBlock ? std::abs(idx - curStart) : INT_MAX;
+        if (dCur <= dHead && dCur <= dTail) { b = curBlock; start = curStart; }
+        else if (dHead <= dTail)            { b = first;    start = 0; }
+        else                                { b = last;     start = count - last->size; }
+        while (idx < start) { b = b->prev; start -= b->size; }          // 游标向后（往头）走
+        while (idx >= start + b->size) { start += b->size; b = b->next; }   // 向前（往尾）走
+        curBlock = b;
+        curStart = start;
+        off = idx - start;
+        return b;
+    }
+
+public:
+    explicit UnrolledLinkList(std::shared_ptr<Pool> sharedPool = nullptr)
+        : pool(sharedPool ? std::move(sharedPool) : std::make_shared<Pool>()),
+          first(nullptr), last(nullptr), count(0), curBlock(nullptr), curStart(0) {}
+
+    virtual ~UnrolledLinkList() { Clear(); }
+
+    // 复制构造 / 赋值重载：新表与源表共享结点池，便于之后 O(1) 拼接
+    UnrolledLinkList(const UnrolledLinkList& other) : UnrolledLinkList(other.pool) {
+        for (Block* b = other.first; b; b = b->next) {
+            for (int i = 0; i < b->size; ++i) PushBack(*b->At(i));
+        }
+    }
+
+    UnrolledLinkList& operator=(const UnrolledLinkList& other) {
+        if (this == &other) return *this;
+        UnrolledLinkList temp(other);
+        Swap(temp);
+        return *this;
+    }
+
+    UnrolledLinkList(UnrolledLinkList&& other) noexcept
+        : pool(other.pool), first(other.first), last(other.last), count(other.count),
+          curBlock(other.curBlock), curStart(other.curStart) {
+        other.first = other.last = other.curBlock = nullptr;
+        other.count = other.curStart = 0;
+    }
+
+    UnrolledLinkList& operator=(UnrolledLinkList&& other) noexcept {
+        if (this != &other) Swap(other);
+        return *this;
+    }
+
+    void Swap(UnrolledLinkList& other) noexcept {
+        std::swap(pool, other.pool);
+        std::swap(first, other.first);
+        std::swap(last, other.last);
+        std::swap(count, other.count);
+        std::swap(curBlock, other.curBlock);
+        std::swap(curStart, other.curStart);
+    }
+
+    std::shared_ptr<Pool> GetPool() const { return pool; }
+
+    bool Empty() const { return count == 0; }
+    int  Length() const { return count; }
+
+    void Clear() {
+        Block* b = first;
+        while (b) {
+            Block* nb = b->next;
+            for (int i = 0; i < b->size; ++i) b->At(i)->~ElemType();
+            pool->Release(b);
+            b = nb;
+        }
+        first = last = curBlock = nullptr;
+        count = curStart = 0;
+    }
+
+    void Traverse(void (*Visit)(ElemType&)) const {
+        for (Block* b = first; b; b = b->next) {
+            for (int i = 0; i < b->size; ++i) Visit(*b->At(i));
+        }
+    }
+
+    bool GetElem(int position, ElemType& e) const {
+        if (position < 1 || position > count) return false;
+        int off;
+        e = *Locate(position - 1, off)->At(off);
+        return true;
+    }
+
+    bool SetElem(int position, const ElemType& e) {
+        if (position < 1 || position > count) return false;
+        int off;
+        *Locate(position - 1, off)->At(off) = e;
+        return true;
+    }
+
+    // 插入：在第 position 个位置“前”插入 e（1 ≤ position ≤ Length()+1）
+    // 目标块已满时一分为二；在表尾追加且尾块已满时直接新开一块（顺序建表块是满的）
+    bool Insert(int position, const ElemType& e) {
+        if (position < 1 || position > count + 1) return false;
+        return InsertValue(position - 1, ElemType(e));      // e 可能引用表内元素，先复制
+    }
+
+    bool Insert(int position, ElemType&& e) {
+        if (position < 1 || position > count + 1) return false;
+        return InsertValue(position - 1, ElemType(std::move(e)));
+    }
+
+    bool PushBack(const ElemType& e) { return Insert(count + 1, e); }
+
+protected:
+    bool InsertValue(int idx, ElemType&& value) {
+        int off, start;
+        Block* b;
+        if (idx == count) {
+            b = last;
+            if (!b || b->size == BlockCap) {
+                b = NewBlockAfter(last);
+                start = count;
+            } else {
+                start = count - b->size;
+            }
+            off = idx - start;
+        } else {
+            b = Locate(idx, off);
+            start = curStart;
+            if (b->size == BlockCap) {
+                int half = BlockCap / 2;
+                SplitAt(b, half);
+                if (off > half) { off -= half; start += half; b = b->next; }
+            }
+        }
+        OpenSlot(b, off);
+        ::new (static_cast<void*>(b->At(off))) ElemType(std::move(value));
+        ++b->size;
+        ++count;
+        curBlock = b;
+        curStart = start;
+        return true;
+    }
+
+public:
+    // 批量追加：逐块填满，O(len)，不经过定位
+    template <class InputIt>
+    void AppendRange(InputIt firstIt, InputIt lastIt) {
+        for (; firstIt != lastIt; ++firstIt) {
+            if (!last || last->size == BlockCap) NewBlockAfter(last);
+            ::new (static_cast<void*>(last->At(last->size))) ElemType(*firstIt);
+            ++last->size;
+            ++count;
+        }
+    }
+
+    // 删除：块空则归还结点池；块不足半满且能与后继块合并时合并，保持块的密度
+    bool Delete(int position, ElemType& e) {
+        if (position < 1 || position > count) return false;
+        RemoveAt(position - 1, &e);
+        return true;
+    }
+
+    bool Delete(int position) {
+        if (position < 1 || position > count) return false;
+        RemoveAt(position - 1, nullptr);
+        return true;
+    }
+
+    // 拼接：把 other 的全部元素移到第 position 个位置之前，other 变为空表。
+    // 共享同一结点池时整串块直接挂接（块边界 O(1)，否则先分裂一个块）；
+    // 结点池不同则退化为逐个移动元素，O(other.Length())
+    bool Splice(int position, UnrolledLinkList& other) {
+        if (&other == this || position < 1 || position > count + 1) return false;
+        if (other.count == 0) return true;
+        if (pool != other.pool) {
+            int pos = position;
+            for (Block* b = other.first; b; b = b->next) {
+                for (int i = 0; i < b->size; ++i) Insert(pos++, std::move(*b->At(i)));
+            }
+            other.Clear();
+            return true;
+        }
+        Block* prev;                                        // other 的块挂在 prev 之后
+        if (position == count + 1) {
+            prev = last;
+        } else if (position == 1) {
+            prev = nullptr;
+        } else {
+            int off;
+            Block* b = Locate(position - 1, off);
+            if (off == 0) prev = b->prev;
+            else { SplitAt(b, off); prev = b; }
+        }
+        Block* next = prev ? prev->next : first;
+        other.first->prev = prev;
+        other.last->next = next;
+        if (prev) prev->next = other.first; else first = other.first;
+        if (next) next->prev = other.last; else last = other.last;
+        count += other.count;
+        curBlock = other.first;
+        curStart = position - 1;
+        other.first = other.last = other.curBlock = nullptr;
+        other.count = other.curStart = 0;
+        return true;
+    }
+
+    bool SpliceBack(UnrolledLinkList& other) { return Splice(count + 1, other); }
+
+protected:
+    void RemoveAt(int idx, ElemType* out) {
+        int off;
+        Block* b = Locate(idx, off);
+        int start = curStart;
+        if (out) *out = std::move(*b->At(off));
+        b->At(off)->~ElemType();
+        CloseSlot(b, off);
+        --b->size;
+        --count;
+
+        if (b->size == 0) {
+            Block* nb = b->next;
+            Block* pb = b->prev;
+            Unlink(b);
+            pool->Release(b);
+            if (nb)      { curBlock = nb; curStart = start; }
+            else if (pb) { curBlock = pb; curStart = start - pb->size; }
+            else         { curBlock = nullptr; curStart = 0; }
+            return;
+        }
+        Block* nb = b->next;
+        if (nb && b->size < BlockCap / 2 && b->size + nb->size <= BlockCap) {
+            MoveElems(b, b->size, nb, 0, nb->size);
+            b->size += nb->size;
+            nb->size = 0;
+            Unlink(nb);
+            pool->Release(nb);
+        }
+        curBlock = b;
+        curStart = start;
+    }
+};
+
+// 性能对比：n 个元素上做“邻近随机访问”（每步位序随机 ±8 的游走）与“倒序扫描”
+// LinkList 只能前向移动游标，回退即从 head 重走；UnrolledLinkList 游标可双向移动
+inline void BenchmarkUnrolledList(int n, int steps) {
+    using Clock = std::chrono::steady_clock;
+    LinkList<int> ll;
+    UnrolledLinkList<int> ul;
+    for (int i = 1; i <= n; ++i) { ll.Insert(i, i); ul.PushBack(i); }
+
+    std::mt19937 rng(7);
+    std::vector<int> walk(steps);
+    int pos = n / 2;
+    for (int& w : walk) {
+        pos += static_cast<int>(rng() % 17) - 8;
+        pos = std::min(std::max(pos, 1), n);
+        w = pos;
+    }
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    long long s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+    int v = 0;
+    auto t0 = Clock::now();
+    for (int w : walk) { ll.GetElem(w, v); s1 += v; }
+    auto t1 = Clock::now();
+    for (int w : walk) { ul.GetElem(w, v); s2 += v; }
+    auto t2 = Clock::now();
+    for (int i = n; i >= 1; --i) { ll.GetElem(i, v); s3 += v; }
+    auto t3 = Clock::now();
+    for (int i = n; i >= 1; --i) { ul.GetElem(i, v); s4 += v; }
+    auto t4 = Clock::now();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "n=" << n << "，邻近随机访问 " << steps << " 次：LinkList " << ms(t0, t1)
+              << " ms，UnrolledLinkList " << ms(t1, t2) << " ms" << (s1 == s2 ? "" : "（结果不一致!）") << "\n"
+              << "n=" << n << "，倒序扫描：LinkList " << ms(t2, t3)
+              << " ms，UnrolledLinkList " << ms(t3, t4) << " ms" << (s3 == s4 ? "" : "（结果不一致!）") << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+
 //=========================== P62–P66: 约瑟夫问题 =========================
 // 与课件一致：用循环链表表示人环，反复数到 m 删除
 void Josephus(int n, int m) {
@@ -481,6 +901,12 @@ void PrintList(const char* title, const LinkList<T>& list) {
     list.Traverse(PrintElem<T>);
     std::cout << "(len=" << list.Length() << ")\n";
 }
+template <class T, int Cap>
+void PrintList(const char* title, const UnrolledLinkList<T, Cap>& list) {
+    std::cout << std::left << std::setw(18) << title << ": ";
+    list.Traverse(PrintElem<T>);
+    std::cout << "(len=" << list.Length() << ")\n";
+}
 
 
 //=============================== 演示主程序 ==============================
@@ -517,7 +943,24 @@ int main() {
     ll.Delete(2);
     PrintList("Delete(2)", ll);
 
-    // --------- 4) 约瑟夫问题（P62–P66）---------
+    // --------- 4) 块状链表（结点池 + 双向游标 + 拼接）---------
+    UnrolledLinkList<int, 4> ua, ub(ua.GetPool());             // 共享结点池
+    for (int i = 1; i <= 10; ++i) ua.PushBack(i);
+    int more[] = {100, 200, 300, 400, 500};
+    ub.AppendRange(more, more + 5);
+    ua.Insert(3, 25);
+    ua.Delete(7);
+    PrintList("UnrolledLinkList", ua);
+    ua.GetElem(9, val);
+    std::cout << "GetElem(9) = " << val;
+    ua.GetElem(2, val);                                        // 游标回退，不必从头走
+    std::cout << ", GetElem(2) = " << val << "\n";
+    ua.Splice(4, ub);                                          // ub 整体插到第 4 个位置前
+    PrintList("Splice(4, ub)", ua);
+    std::cout << "ub.Length() = " << ub.Length() << "\n";
+    BenchmarkUnrolledList(20000, 20000);
+
+    // --------- 5) 约瑟夫问题（P62–P66）---------
     std::cout << "\n[约瑟夫问题] n=8, m=3\n";
     Josephus(8, 3);
 